@@ -0,0 +1,40 @@
+@echo off
+cd /d "%~dp0"
+
+REM Programas de medicion de bench\ (sin SFML). Se corren desde esta carpeta
+REM para que encuentren assets\maze.txt
+if not exist build mkdir build
+
+echo =============================
+echo Compilando y corriendo bench\
+echo =============================
+
+call :BENCH SolverBench "src\AStar.cpp src\BFS.cpp src\BitParallelBFS.cpp src\CompactGrid.cpp src\Grid.cpp src\IncrementalPlanner.cpp src\MazeLoader.cpp"
+if errorlevel 1 goto :FAIL
+call :BENCH GridBench "src\Grid.cpp"
+if errorlevel 1 goto :FAIL
+call :BENCH CompactBench "src\BFS.cpp src\CompactGrid.cpp src\Grid.cpp"
+if errorlevel 1 goto :FAIL
+call :BENCH LayoutBench "src\BFS.cpp src\Grid.cpp"
+if errorlevel 1 goto :FAIL
+call :BENCH QueryBench "src\BFS.cpp src\Grid.cpp src\GridSnapshot.cpp src\PathQueries.cpp src\ThreadPool.cpp"
+if errorlevel 1 goto :FAIL
+call :BENCH TiledBench "src\Grid.cpp src\MazeLoader.cpp src\TiledGrid.cpp"
+if errorlevel 1 goto :FAIL
+
+echo Benchmarks completados.
+pause
+goto :EOF
+
+:BENCH
+echo.
+echo ---- %1 ----
+g++ -O2 -std=c++17 -I include bench\%1.cpp %~2 -o build\%1.exe
+if errorlevel 1 exit /b 1
+build\%1.exe
+exit /b 0
+
+:FAIL
+echo Error compilando un benchmark.
+pause
+exit /b 1
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MazeLoader.hpp"
+
+// Mapas de prueba para los programas de bench/: el laberinto del juego (si
+// se encuentra) y mapas al azar con una proporción de muros dada, siempre con
+// la misma semilla para que las corridas se puedan comparar.
+struct BenchMap {
+    std::string name;
+    CellGrid grid;
+    int W = 0, H = 0;
+    int startX = 0, startY = 0;
+    int goalX = 0, goalY = 0;
+};
+
+// Inicio arriba a la izquierda y meta abajo a la derecha, cada uno en una
+// esquina de 3x3 sin muros para que no quede encerrado
+inline BenchMap randomMap(int W, int H, double walls, unsigned seed = 1) {
+    BenchMap m;
+    m.name = std::to_string(W) + "x" + std::to_string(H) + " " + std::to_string(int(walls * 100 + 0.5)) + "%";
+    m.W = W;
+    m.H = H;
+    m.goalX = W - 1;
+    m.goalY = H - 1;
+    m.grid.resize(W, H);
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution wall(walls);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            bool corner = (x < 3 && y < 3) || (x >= W - 3 && y >= H - 3);
+            if (wall(rng) && !corner) m.grid.setType(y*W + x, CellType::Wall);
+        }
+    }
+    m.grid.setType(0, CellType::Start);
+    m.grid.setType(W * H - 1, CellType::Goal);
+    return m;
+}
+
+// assets/maze.txt visto desde EscapeTheGrid/, build/ o bench/
+inline bool loadGameMaze(BenchMap& m) {
+    for (const char* path : {"assets/maze.txt", "../assets/maze.txt"}) {
+        MazeInfo maze;
+        if (!loadMazeFile(path, m.grid, maze)) continue;
+        m.name = "maze.txt";
+        m.W = maze.W;
+        m.H = maze.H;
+        m.startX = maze.startX;
+        m.startY = maze.startY;
+        m.goalX = maze.goalX;
+        m.goalY = maze.goalY;
+        return true;
+    }
+    return false;
+}
+
+inline double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
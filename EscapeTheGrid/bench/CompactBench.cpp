@@ -0,0 +1,79 @@
+// BFS sobre CellGrid (BFSWorkspace) contra el mismo BFS sobre la vista de
+// 2 bits por celda (CompactBFS): bytes de cada tablero y tiempo por búsqueda,
+// en mapas al azar con 30% de muros. La memoria se cuenta con las reservas
+// que hace cada tablero al armarse.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/CompactBench.cpp src/BFS.cpp src/CompactGrid.cpp src/Grid.cpp).
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "BFS.hpp"
+#include "BenchMaps.hpp"
+#include "CompactGrid.hpp"
+
+using namespace std;
+
+static size_t allocatedBytes = 0;
+
+void* operator new(size_t n) {
+    allocatedBytes += n;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Promedio en ms de repetir 'solve' hasta juntar 300 ms (al menos 3 veces)
+template <class F>
+static double average(F solve) {
+    solve();   // calentamiento
+    int runs = 0;
+    double ms = 0;
+    do {
+        auto t0 = chrono::steady_clock::now();
+        solve();
+        ms += msSince(t0);
+        ++runs;
+    } while (ms < 300 || runs < 3);
+    return ms / runs;
+}
+
+int main() {
+    printf("%-11s %-12s %10s %7s %10s %10s %9s\n", "tablero", "solver", "MB", "largo", "nodos", "ms", "ns/nodo");
+    // Sin camino (largo "-") el BFS recorre toda la zona del inicio
+    auto length = [](const vector<pair<int,int>>& p) { return p.empty() ? string("-") : to_string(p.size() - 1); };
+    for (int side : {1000, 2000, 4000}) {
+        size_t before = allocatedBytes;
+        BenchMap m = randomMap(side, side, 0.3);
+        double gridMB = (allocatedBytes - before) / 1e6;
+
+        before = allocatedBytes;
+        CompactGrid compact(m.grid);
+        double compactMB = (allocatedBytes - before) / 1e6;
+
+        BFSWorkspace workspace;
+        CompactBFS compactBfs;
+        vector<pair<int,int>> path, compactPath;
+        double gridMs = average([&] {
+            workspace.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+        });
+        double compactMs = average([&] {
+            compactBfs.solve(compact, m.startX, m.startY, m.goalX, m.goalY, compactPath);
+        });
+        if (path != compactPath) printf("Los caminos no coinciden en %s\n", m.name.c_str());
+
+        string name = to_string(side) + "x" + to_string(side);
+        int expanded = workspace.lastStats().expanded;
+        printf("%-11s %-12s %10.2f %7s %10d %10.2f %9.1f\n", name.c_str(), "CellGrid", gridMB,
+               length(path).c_str(), expanded, gridMs, gridMs * 1e6 / expanded);
+        expanded = compactBfs.lastStats().expanded;
+        printf("%-11s %-12s %10.2f %7s %10d %10.2f %9.1f\n", name.c_str(), "CompactGrid", compactMB,
+               length(compactPath).c_str(), expanded, compactMs, compactMs * 1e6 / expanded);
+    }
+    return 0;
+}
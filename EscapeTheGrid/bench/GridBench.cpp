@@ -0,0 +1,97 @@
+// Memoria por celda y tiempo de limpieza de CellGrid contra el vector<Cell>
+// que usaba el juego antes (tipo más cuatro bool por celda).
+// La memoria se mide contando los bytes que pide cada tablero al armarse.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/GridBench.cpp src/Grid.cpp).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "BenchMaps.hpp"
+#include "Grid.hpp"
+
+using namespace std;
+
+static size_t allocatedBytes = 0;
+
+void* operator new(size_t n) {
+    allocatedBytes += n;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// La celda como era antes de CellGrid
+struct Cell {
+    CellType type = CellType::Empty;
+    bool visited = false;
+    bool isOnPath = false;
+    bool hasBeenTraversed = false;
+    bool isReflected = false;
+};
+
+// Mejor tiempo de 'runs' repeticiones, en ms
+template <class F>
+static double best(int runs, F f) {
+    double result = 1e30;
+    for (int r = 0; r < runs; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        f();
+        result = min(result, msSince(t0));
+    }
+    return result;
+}
+
+int main() {
+    const int RUNS = 20;
+    printf("%-11s %-12s %11s %12s %12s\n", "tablero", "estructura", "bytes/celda", "limpiar ms", "muros ms");
+    for (int side : {1000, 2000, 4000}) {
+        BenchMap m = randomMap(side, side, 0.2);
+        const int N = side * side;
+        long walls = 0;
+
+        size_t before = allocatedBytes;
+        vector<Cell> cells(N);
+        double cellBytes = double(allocatedBytes - before) / N;
+        for (int i = 0; i < N; ++i) cells[i].type = m.grid.type(i);
+
+        before = allocatedBytes;
+        CellGrid grid;
+        grid.resize(side, side);
+        double gridBytes = double(allocatedBytes - before) / N;
+        for (int i = 0; i < N; ++i) grid.setType(i, m.grid.type(i));
+
+        // Lo que hacían resetGame()/bfsSolve() antes de cada búsqueda
+        double cellClear = best(RUNS, [&] {
+            for (Cell& c : cells) {
+                c.visited = false;
+                c.isOnPath = false;
+            }
+        });
+        double gridClear = best(RUNS, [&] {
+            grid.clear(CellFlag::Visited);
+            grid.clear(CellFlag::OnPath);
+        });
+
+        double cellScan = best(RUNS, [&] {
+            walls = 0;
+            for (const Cell& c : cells) walls += c.type == CellType::Wall;
+        });
+        long cellWalls = walls;
+        double gridScan = best(RUNS, [&] {
+            walls = 0;
+            for (int i = 0; i < N; ++i) walls += grid.isWall(i);
+        });
+        if (walls != cellWalls) printf("Los muros no coinciden: %ld contra %ld\n", walls, cellWalls);
+
+        string name = to_string(side) + "x" + to_string(side);
+        printf("%-11s %-12s %11.2f %12.3f %12.3f\n", name.c_str(), "vector<Cell>", cellBytes, cellClear, cellScan);
+        printf("%-11s %-12s %11.2f %12.3f %12.3f\n", name.c_str(), "CellGrid", gridBytes, gridClear, gridScan);
+    }
+    return 0;
+}
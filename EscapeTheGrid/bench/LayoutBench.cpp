@@ -0,0 +1,65 @@
+// BFS con las marcas, padres y la grilla en cada orden de CellLayout.hpp
+// (filas, Morton, bloques de 8x8 y de 16x16) contra BFSWorkspace, en ms por
+// búsqueda de esquina a esquina. No hay contadores de fallos de caché: es
+// tiempo de reloj, y la diferencia entre órdenes es lo que cuesta la
+// localidad en tableros grandes.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/LayoutBench.cpp src/BFS.cpp src/Grid.cpp).
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BFS.hpp"
+#include "BenchMaps.hpp"
+#include "CellLayout.hpp"
+#include "LayoutBFS.hpp"
+
+using namespace std;
+
+// Promedio en ms de repetir 'solve' hasta juntar 300 ms (al menos 3 veces)
+template <class F>
+static double average(F solve) {
+    solve();   // calentamiento
+    int runs = 0;
+    double ms = 0;
+    do {
+        auto t0 = chrono::steady_clock::now();
+        solve();
+        ms += msSince(t0);
+        ++runs;
+    } while (ms < 300 || runs < 3);
+    return ms / runs;
+}
+
+// Tiempo de LayoutBFS<Layout> sobre m; avisa si el camino no es 'expected'
+template <class Layout>
+static double layoutMs(const BenchMap& m, const vector<pair<int,int>>& expected, const char* name) {
+    LayoutGrid<Layout> grid(m.grid);
+    LayoutBFS<Layout> bfs;
+    vector<pair<int,int>> path;
+    double ms = average([&] { bfs.solve(grid, m.startX, m.startY, m.goalX, m.goalY, path); });
+    if (path != expected) printf("%s: el camino no coincide con BFSWorkspace en %s\n", name, m.name.c_str());
+    return ms;
+}
+
+int main() {
+    printf("%-14s %12s %8s %8s %8s %8s\n", "mapa", "BFSWorkspace", "filas", "Morton", "bloq8", "bloq16");
+    for (double walls : {0.3, 0.05}) {
+        for (int side : {1000, 4000}) {
+            BenchMap m = randomMap(side, side, walls);
+            BFSWorkspace workspace;
+            vector<pair<int,int>> path;
+            double base = average([&] {
+                workspace.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+            });
+            double rows = layoutMs<RowMajorLayout>(m, path, "filas");
+            double morton = layoutMs<MortonLayout>(m, path, "Morton");
+            double tiles8 = layoutMs<TiledLayout<3>>(m, path, "bloq8");
+            double tiles16 = layoutMs<TiledLayout<4>>(m, path, "bloq16");
+            printf("%-14s %12.1f %8.1f %8.1f %8.1f %8.1f\n", m.name.c_str(), base, rows, morton, tiles8, tiles16);
+        }
+    }
+    return 0;
+}
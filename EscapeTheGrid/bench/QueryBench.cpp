@@ -0,0 +1,87 @@
+// Largos de muchos caminos (inicio, meta) sobre un GridSnapshot: PathQueries,
+// que hace un BFS por inicio distinto, contra un BFSWorkspace::solve por
+// consulta. PathQueries se mide con un ThreadPool de un hilo y con uno de
+// todos los núcleos; con 1 consulta por inicio lo único que cambia son los
+// hilos, con 8 además se comparte cada BFS. Avisa si algún largo difiere.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/QueryBench.cpp src/BFS.cpp src/Grid.cpp src/GridSnapshot.cpp
+// src/PathQueries.cpp src/ThreadPool.cpp).
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BFS.hpp"
+#include "BenchMaps.hpp"
+#include "GridSnapshot.hpp"
+#include "PathQueries.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+// 'count' consultas en grupos de 'perStart' con el mismo inicio, todas entre
+// celdas que no son muro
+static vector<PathQuery> randomQueries(const BenchMap& m, int count, int perStart) {
+    mt19937 rng(3);
+    uniform_int_distribution<int> anyCell(0, m.W * m.H - 1);
+    auto openCell = [&] {
+        int c;
+        do c = anyCell(rng); while (m.grid.isWall(c));
+        return c;
+    };
+    vector<PathQuery> queries;
+    int start = 0;
+    for (int k = 0; k < count; ++k) {
+        if (k % perStart == 0) start = openCell();
+        int goal = openCell();
+        queries.push_back({start % m.W, start / m.W, goal % m.W, goal / m.W});
+    }
+    return queries;
+}
+
+int main() {
+    ThreadPool single(1), all;
+    PathQueries singleBatch(single), allBatch(all);
+    BFSWorkspace workspace;
+
+    printf("%-14s %9s %10s %12s %10s %10s %10s\n", "mapa", "consultas", "por inicio",
+           "separadas ms", "1 hilo ms", "hilos", "N hilos ms");
+    for (int side : {500, 1000}) {
+        BenchMap m = randomMap(side, side, 0.2);
+        GridSnapshot snapshot(m.grid);
+        for (int perStart : {1, 8}) {
+            const int COUNT = 200;
+            vector<PathQuery> queries = randomQueries(m, COUNT, perStart);
+
+            vector<int> separate(COUNT);
+            vector<pair<int,int>> path;
+            auto t0 = chrono::steady_clock::now();
+            for (int k = 0; k < COUNT; ++k) {
+                const PathQuery& q = queries[k];
+                bool found = workspace.solve(m.grid, m.W, m.H, q.startX, q.startY, q.goalX, q.goalY, path);
+                separate[k] = found ? (int)path.size() - 1 : -1;
+            }
+            double separateMs = msSince(t0);
+
+            vector<int> lengths;
+            singleBatch.solve(snapshot, queries, lengths);   // calentamiento
+            t0 = chrono::steady_clock::now();
+            singleBatch.solve(snapshot, queries, lengths);
+            double singleMs = msSince(t0);
+            if (lengths != separate) printf("PathQueries (1 hilo) no coincide en %s\n", m.name.c_str());
+
+            allBatch.solve(snapshot, queries, lengths);
+            t0 = chrono::steady_clock::now();
+            allBatch.solve(snapshot, queries, lengths);
+            double allMs = msSince(t0);
+            if (lengths != separate) printf("PathQueries (%d hilos) no coincide en %s\n", all.size(), m.name.c_str());
+
+            printf("%-14s %9d %10d %12.1f %10.1f %10d %10.1f\n", m.name.c_str(), COUNT, perStart,
+                   separateMs, singleMs, all.size(), allMs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+// Comparación de solvers sobre el laberinto del juego y mapas generados:
+// nodos expandidos, pico de la lista abierta, ns por nodo y reservas de
+// memoria por búsqueda, comprobando que todos den el largo del BFS original.
+// Las reservas se cuentan reemplazando operator new en este programa.
+// Después, D* Lite (IncrementalPlanner) como lo usa el modo automático: la
+// búsqueda inicial y las replanificaciones tras cambios de muros y de meta,
+// contra un BFSWorkspace desde cero en cada paso.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/SolverBench.cpp src/AStar.cpp src/BFS.cpp src/BitParallelBFS.cpp
+// src/CompactGrid.cpp src/Grid.cpp src/IncrementalPlanner.cpp src/MazeLoader.cpp).
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "AStar.hpp"
+#include "BFS.hpp"
+#include "BitParallelBFS.hpp"
+#include "BenchMaps.hpp"
+#include "IncrementalPlanner.hpp"
+
+using namespace std;
+
+static long allocationCount = 0;
+
+void* operator new(size_t n) {
+    ++allocationCount;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// bfsSolve() como era antes de BFSWorkspace: matrices de vector por búsqueda
+// y una std::queue de pares
+static bool originalBfs(const CellGrid& grid, int W, int H, int startX, int startY, int goalX, int goalY,
+                        vector<pair<int,int>>& path, SolveStats& stats) {
+    path.clear();
+    vector<vector<bool>> vis(H, vector<bool>(W, false));
+    vector<vector<pair<int,int>>> parent(H, vector<pair<int,int>>(W, {-1,-1}));
+    queue<pair<int,int>> q;
+    q.push({startY, startX});
+    vis[startY][startX] = true;
+
+    int dirs[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
+    bool found = false;
+    while (!q.empty()) {
+        auto [y,x] = q.front(); q.pop();
+        stats.expanded++;
+        if (y == goalY && x == goalX) {
+            found = true;
+            break;
+        }
+        for (auto& d : dirs) {
+            int ny = y + d[0];
+            int nx = x + d[1];
+            if (ny < 0 || ny >= H || nx < 0 || nx >= W) continue;
+            if (grid.isWall(ny*W + nx) || vis[ny][nx]) continue;
+            vis[ny][nx] = true;
+            parent[ny][nx] = {y,x};
+            q.push({ny,nx});
+        }
+    }
+
+    if (found) {
+        for (int cy = goalY, cx = goalX; cy != -1; ) {
+            path.push_back({cy,cx});
+            auto p = parent[cy][cx];
+            cy = p.first;
+            cx = p.second;
+        }
+        reverse(path.begin(), path.end());
+    }
+    return found;
+}
+
+struct Solver {
+    const char* name;
+    // Devuelve si encontró camino y deja las métricas de la búsqueda en stats
+    function<bool(const BenchMap&, vector<pair<int,int>>&, SolveStats&)> solve;
+};
+
+// Filas de D* Lite sobre una copia de m: la búsqueda inicial, 20 muros al
+// azar, 20 muros puestos sobre el camino y un movimiento de la meta. Cada paso
+// replanifica y resuelve con BFSWorkspace sobre la misma grilla; las filas de
+// varios pasos muestran el promedio. Devuelve false si algún largo no coincide
+static bool incrementalRows(const BenchMap& m, BFSWorkspace& workspace) {
+    CellGrid grid = m.grid;
+    int W = m.W, H = m.H, goalX = m.goalX, goalY = m.goalY;
+    IncrementalPlanner planner;
+    vector<pair<int,int>> path, bfsPath;
+    mt19937 rng(2);
+    uniform_int_distribution<int> anyCell(0, W * H - 1);
+
+    double plannerMs = 0, bfsMs = 0;
+    long plannerNodes = 0, bfsNodes = 0;
+    int steps = 0;
+    bool same = true;
+    auto step = [&] {
+        auto t0 = chrono::steady_clock::now();
+        planner.replan(grid, W, H, m.startX, m.startY, goalX, goalY, path);
+        plannerMs += msSince(t0);
+        plannerNodes += planner.lastExpanded();
+
+        t0 = chrono::steady_clock::now();
+        workspace.solve(grid, W, H, m.startX, m.startY, goalX, goalY, bfsPath);
+        bfsMs += msSince(t0);
+        bfsNodes += workspace.lastStats().expanded;
+        ++steps;
+        if (path.size() != bfsPath.size()) {
+            printf("%s: D* Lite da largo %d y BFS %d\n", m.name.c_str(), (int)path.size() - 1, (int)bfsPath.size() - 1);
+            same = false;
+        }
+    };
+    auto row = [&](const char* what) {
+        string length = path.empty() ? string("-") : to_string(path.size() - 1);
+        printf("%-14s %-18s %7s %10ld %9.2f %10ld %9.2f\n", m.name.c_str(), what, length.c_str(),
+               plannerNodes / steps, plannerMs / steps, bfsNodes / steps, bfsMs / steps);
+        plannerMs = bfsMs = 0;
+        plannerNodes = bfsNodes = 0;
+        steps = 0;
+    };
+    // Como triggerMapEvent(): solo celdas vacías o muros, nunca inicio ni meta
+    auto toggle = [&](int c) {
+        CellType t = grid.type(c);
+        if (t != CellType::Empty && t != CellType::Wall) return;
+        grid.setType(c, t == CellType::Empty ? CellType::Wall : CellType::Empty);
+        planner.cellChanged(c % W, c / W);
+    };
+
+    step();
+    row("inicial");
+    for (int k = 0; k < 20; ++k) {
+        toggle(anyCell(rng));
+        step();
+    }
+    row("muro al azar");
+    for (int k = 0; k < 20; ++k) {
+        if (path.size() > 2) {
+            auto [y, x] = path[uniform_int_distribution<int>(1, (int)path.size() - 2)(rng)];
+            toggle(y*W + x);
+        }
+        step();
+    }
+    row("muro en camino");
+    // Como moveGoal(): la meta pasa a una celda vacía al azar
+    int target;
+    do target = anyCell(rng); while (grid.type(target) != CellType::Empty);
+    grid.setType(goalY*W + goalX, CellType::Empty);
+    grid.setType(target, CellType::Goal);
+    goalX = target % W;
+    goalY = target / W;
+    step();
+    row("meta movida");
+    return same;
+}
+
+int main() {
+    vector<BenchMap> maps;
+    BenchMap game;
+    if (loadGameMaze(game)) maps.push_back(move(game));
+    maps.push_back(randomMap(256, 256, 0.25));
+    maps.push_back(randomMap(1000, 1000, 0.2));
+    maps.push_back(randomMap(1000, 1000, 0.05));
+    maps.push_back(randomMap(2000, 2000, 0.2));
+
+    BFSWorkspace workspace;
+    BitParallelBFS bitParallel;
+    BidirectionalBFS bidirectional;
+    AStarSolver astar;
+
+    vector<Solver> solvers = {
+        {"BFS original", [](const BenchMap& m, vector<pair<int,int>>& path, SolveStats& stats) {
+            return originalBfs(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path, stats);
+        }},
+        {"BFSWorkspace", [&](const BenchMap& m, vector<pair<int,int>>& path, SolveStats& stats) {
+            bool found = workspace.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+            stats.expanded = workspace.lastStats().expanded;
+            return found;
+        }},
+        {"BFS bidireccional", [&](const BenchMap& m, vector<pair<int,int>>& path, SolveStats& stats) {
+            bool found = bidirectional.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+            stats.expanded = bidirectional.lastStats().expanded;
+            return found;
+        }},
+        {"A*", [&](const BenchMap& m, vector<pair<int,int>>& path, SolveStats& stats) {
+            bool found = astar.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+            stats.expanded = astar.lastStats().expanded;
+            stats.peakOpen = astar.lastStats().peakOpen;
+            return found;
+        }},
+        {"BFS por bits", [&](const BenchMap& m, vector<pair<int,int>>& path, SolveStats& stats) {
+            bool found = bitParallel.solve(m.grid, m.W, m.H, m.startX, m.startY, m.goalX, m.goalY, path);
+            stats.expanded = bitParallel.lastStats().expanded;
+            return found;
+        }},
+    };
+
+    // Todos tienen que dar el largo del BFS original (el camino puede ser otro)
+    bool same = true;
+    printf("%-14s %-18s %7s %10s %8s %9s %12s\n", "mapa", "solver", "largo", "nodos", "pico", "ns/nodo", "reservas");
+    for (const BenchMap& m : maps) {
+        size_t expected = 0;
+        for (const Solver& s : solvers) {
+            vector<pair<int,int>> path;
+            SolveStats stats;
+            s.solve(m, path, stats);   // calentamiento: el espacio de trabajo ya queda armado
+
+            // Repetir hasta juntar al menos 200 ms
+            int runs = 0;
+            long allocations = 0;
+            double ms = 0;
+            do {
+                stats = SolveStats();
+                long before = allocationCount;
+                auto t0 = chrono::steady_clock::now();
+                s.solve(m, path, stats);
+                ms += msSince(t0);
+                allocations += allocationCount - before;
+                ++runs;
+            } while (ms < 200 && runs < 1000);
+
+            double nsPerNode = stats.expanded ? ms * 1e6 / runs / stats.expanded : 0;
+            // Solo A* lleva la cuenta de la lista abierta
+            string peak = stats.peakOpen ? to_string(stats.peakOpen) : "-";
+            printf("%-14s %-18s %7d %10d %8s %9.1f %12.1f\n", m.name.c_str(), s.name,
+                   (int)path.size() - 1, stats.expanded, peak.c_str(), nsPerNode, (double)allocations / runs);
+            if (&s == &solvers[0]) {
+                expected = path.size();
+            } else if (path.size() != expected) {
+                printf("%s: %s da largo %d y el BFS original %d\n", m.name.c_str(), s.name,
+                       (int)path.size() - 1, (int)expected - 1);
+                same = false;
+            }
+        }
+    }
+
+    printf("\n%-14s %-18s %7s %10s %9s %10s %9s\n", "mapa", "D* Lite", "largo", "nodos", "ms", "nodos BFS", "ms BFS");
+    for (const BenchMap& m : maps) {
+        same = incrementalRows(m, workspace) && same;
+    }
+    return same ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+// Tablero en disco por bloques (TiledGrid) contra el CellGrid en memoria, en
+// un mapa al azar de 4000x4000 con 20% de muros: carga del texto, conversión
+// al formato por bloques, una caminata al azar de 20M pasos y un recorrido
+// por filas contando muros, con la memoria de bloques acotada a 8 MB. La
+// memoria del CellGrid se cuenta con las reservas de su resize(); "texto ms"
+// es loadMazeFile() para CellGrid y convert() para TiledGrid.
+// Escribe tiled_bench.txt y tiled_bench.etgt en la carpeta actual y los borra
+// al terminar.
+//
+// Se arma con bench.bat (o a mano: g++ -O2 -std=c++17 -I include
+// bench/TiledBench.cpp src/Grid.cpp src/MazeLoader.cpp src/TiledGrid.cpp).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <random>
+#include <string>
+
+#include "BenchMaps.hpp"
+#include "Grid.hpp"
+#include "MazeLoader.hpp"
+#include "TiledGrid.hpp"
+
+using namespace std;
+
+const char* TEXT_PATH = "tiled_bench.txt";
+const char* TILED_PATH = "tiled_bench.etgt";
+
+static size_t allocatedBytes = 0;
+
+void* operator new(size_t n) {
+    allocatedBytes += n;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// Caminata al azar que no entra en muros; devuelve la suma de posiciones para
+// que el compilador no la descarte
+template <class IsWall>
+static long walk(int W, int H, long steps, IsWall isWall) {
+    mt19937 rng(5);
+    const int dx[4] = {0, 0, 1, -1}, dy[4] = {1, -1, 0, 0};
+    int x = 0, y = 0;
+    long sum = 0;
+    for (long s = 0; s < steps; ++s) {
+        int d = rng() & 3;
+        int nx = x + dx[d], ny = y + dy[d];
+        if (nx < 0 || nx >= W || ny < 0 || ny >= H || isWall(nx, ny)) continue;
+        x = nx;
+        y = ny;
+        sum += x + y;
+    }
+    return sum;
+}
+
+int main() {
+    const int SIDE = 4000;
+    const long STEPS = 20000000;
+    const size_t BUDGET = 8 << 20;
+
+    BenchMap m = randomMap(SIDE, SIDE, 0.2);
+    {
+        ofstream out(TEXT_PATH);
+        out << SIDE << " " << SIDE << "\n0 0\n" << SIDE - 1 << " " << SIDE - 1 << "\n";
+        string line;
+        for (int y = 0; y < SIDE; ++y) {
+            line.clear();
+            for (int x = 0; x < SIDE; ++x) {
+                line += m.grid.isWall(y*SIDE + x) ? '#' : '.';
+                line += x + 1 < SIDE ? ' ' : '\n';
+            }
+            out << line;
+        }
+    }
+
+    CellGrid grid;
+    MazeInfo maze;
+    size_t before = allocatedBytes;
+    grid.resize(SIDE, SIDE);
+    double gridMB = (allocatedBytes - before) / 1e6;
+    auto t0 = chrono::steady_clock::now();
+    if (!loadMazeFile(TEXT_PATH, grid, maze)) return 1;
+    double loadMs = msSince(t0);
+
+    t0 = chrono::steady_clock::now();
+    if (!TiledGrid::convert(TEXT_PATH, TILED_PATH)) return 1;
+    double convertMs = msSince(t0);
+
+    TiledGrid tiled;
+    if (!tiled.open(TILED_PATH, BUDGET)) return 1;
+
+    t0 = chrono::steady_clock::now();
+    long gridWalk = walk(SIDE, SIDE, STEPS, [&](int x, int y) { return grid.isWall(y*SIDE + x); });
+    double gridWalkMs = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    long tiledWalk = walk(SIDE, SIDE, STEPS, [&](int x, int y) { return tiled.type(x, y) == CellType::Wall; });
+    double tiledWalkMs = msSince(t0);
+    long long walkLoads = tiled.tileLoads();
+    if (gridWalk != tiledWalk) printf("Las caminatas no coinciden\n");
+
+    long gridWalls = 0, tiledWalls = 0;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < SIDE * SIDE; ++i) gridWalls += grid.isWall(i);
+    double gridScanMs = msSince(t0);
+    t0 = chrono::steady_clock::now();
+    for (int y = 0; y < SIDE; ++y) {
+        for (int x = 0; x < SIDE; ++x) tiledWalls += tiled.type(x, y) == CellType::Wall;
+    }
+    double tiledScanMs = msSince(t0);
+    if (gridWalls != tiledWalls) printf("Los muros no coinciden: %ld contra %ld\n", tiledWalls, gridWalls);
+
+    string name = to_string(SIDE) + "x" + to_string(SIDE);
+    printf("%-11s %-10s %6s %9s %12s %12s %13s %13s\n", "tablero", "estructura", "MB",
+           "texto ms", "caminata ms", "recorrer ms", "bloques cam.", "bloques rec.");
+    printf("%-11s %-10s %6.1f %9.0f %12.0f %12.0f %13s %13s\n", name.c_str(), "CellGrid",
+           gridMB, loadMs, gridWalkMs, gridScanMs, "-", "-");
+    printf("%-11s %-10s %6.1f %9.0f %12.0f %12.0f %13lld %13lld\n", name.c_str(), "TiledGrid",
+           tiled.residentBytes() / 1e6, convertMs, tiledWalkMs, tiledScanMs,
+           walkLoads, tiled.tileLoads() - walkLoads);
+
+    tiled.close();
+    remove(TEXT_PATH);
+    remove(TILED_PATH);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BFS.hpp"
+#include "Grid.hpp"
+
+// Cola por cubetas para prioridades enteras pequeñas que no decrecen
+// (f = g + h con heurística consistente). Dentro de una cubeta se saca
+// lo último que entró, lo que favorece los nodos más profundos.
+class BucketQueue {
+public:
+    void clear();
+    void push(int priority, int32_t cell);
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    int32_t pop();
+
+private:
+    std::vector<std::vector<int32_t>> buckets;
+    int current = 0;
+    int top = -1;       // cubeta más alta usada, para limpiar solo lo necesario
+    int count = 0;
+};
+
+// A* con heurística Manhattan (admisible para pasos unitarios en 4 direcciones)
+// y lista abierta por cubetas. Marcas por época como BFSWorkspace.
+class AStarSolver {
+public:
+    void resize(int W, int H);
+
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    int W = 0, H = 0;
+    uint32_t epoch = 0;
+    std::vector<uint32_t> seen;     // g y parent válidos en esta época
+    std::vector<uint32_t> closed;
+    std::vector<int32_t> g;
+    std::vector<int32_t> parent;
+    BucketQueue open;
+    SolveStats stats;
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "CompactGrid.hpp"
+#include "Grid.hpp"
+
+// Estrategias de búsqueda seleccionables para bfsSolve()
+enum class SolverStrategy { BFS, Bidirectional, AStar, JumpPoint, Hierarchical, Parallel };
+
+inline const char* strategyName(SolverStrategy s) {
+    switch (s) {
+        case SolverStrategy::Bidirectional: return "BFS bidireccional";
+        case SolverStrategy::AStar: return "A*";
+        case SolverStrategy::JumpPoint: return "Jump Point Search";
+        case SolverStrategy::Hierarchical: return "HPA*";
+        case SolverStrategy::Parallel: return "BFS paralelo";
+        case SolverStrategy::BFS:
+        default: return "BFS";
+    }
+}
+
+inline SolverStrategy nextStrategy(SolverStrategy s) {
+    switch (s) {
+        case SolverStrategy::BFS: return SolverStrategy::Bidirectional;
+        case SolverStrategy::Bidirectional: return SolverStrategy::AStar;
+        case SolverStrategy::AStar: return SolverStrategy::JumpPoint;
+        case SolverStrategy::JumpPoint: return SolverStrategy::Hierarchical;
+        case SolverStrategy::Hierarchical: return SolverStrategy::Parallel;
+        case SolverStrategy::Parallel:
+        default: return SolverStrategy::BFS;
+    }
+}
+
+// Métricas de una búsqueda
+struct SolveStats {
+    int expanded = 0;       // nodos sacados de la cola
+    int allocations = 0;    // reservas de memoria hechas por el espacio de trabajo
+    long long nanos = 0;    // duración de la búsqueda
+    int peakOpen = 0;       // tamaño máximo de la lista abierta (A*, JPS)
+};
+
+// Espacio de trabajo de BFS reutilizable entre llamadas.
+// Todo es plano (índice y*W + x): cola de índices, marcas de visita por
+// época (no hace falta limpiarlas) y padres como int32. Solo se reserva
+// memoria cuando cambian las dimensiones del laberinto.
+class BFSWorkspace {
+public:
+    void resize(int W, int H);
+
+    // Camino (y,x) desde el inicio hasta la meta, ambos incluidos.
+    // Devuelve false si la meta es inalcanzable.
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+    // Celdas expandidas en la última búsqueda, en orden de salida de la cola
+    const int32_t* expandedCells() const { return queue.data(); }
+
+private:
+    int W = 0, H = 0;
+    uint32_t epoch = 0;
+    std::vector<uint32_t> stamp;
+    std::vector<int32_t> parent;
+    std::vector<int32_t> queue;
+    SolveStats stats;
+};
+
+// El mismo BFS sobre la vista compacta de 2 bits por celda. Recorre los
+// índices con relleno de CompactGrid, así que los vecinos no comprueban bordes.
+class CompactBFS {
+public:
+    bool solve(const CompactGrid& grid, int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    void resize(int cells);
+
+    int cells = 0;
+    uint32_t epoch = 0;
+    std::vector<uint32_t> stamp;
+    std::vector<int32_t> parent;
+    std::vector<int32_t> queue;
+    SolveStats stats;
+};
+
+// BFS bidireccional: crece un frente desde el inicio y otro desde la meta,
+// expandiendo siempre por niveles completos el frente más chico. Al terminar
+// el primer nivel en que los frentes se tocan, el mejor punto de encuentro de
+// ese nivel da un camino mínimo.
+class BidirectionalBFS {
+public:
+    void resize(int W, int H);
+
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    // Un lado de la búsqueda (0 = desde el inicio, 1 = desde la meta)
+    struct Side {
+        std::vector<uint32_t> stamp;
+        std::vector<int32_t> dist;
+        std::vector<int32_t> parent;
+        std::vector<int32_t> queue;
+        int head = 0, tail = 0;
+    };
+
+    int W = 0, H = 0;
+    uint32_t epoch = 0;
+    Side sides[2];
+    SolveStats stats;
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BFS.hpp"
+#include "Grid.hpp"
+
+// BFS por frentes de onda sobre tableros de bits (un bit por celda, 64 por palabra).
+// Cada capa se expande con desplazamientos y AND/OR por palabra (AVX2 si la CPU
+// lo soporta). Como los vecinos de la capa d solo pueden estar en d-1, d o d+1,
+// basta con las dos últimas capas: no hay arreglo de visitados y la capa d+1 se
+// escribe sobre la d-1. Cada fila guarda el rango de palabras no nulas, así el
+// trabajo por capa es proporcional al frente y no al tablero. Para reconstruir
+// el camino se guardan puntos de control cada ~sqrt(D) capas y se regeneran los
+// frentes de cada tramo al recorrerlo hacia atrás.
+//
+// El camino tiene el mismo largo que el de BFSWorkspace, pero puede no ser el
+// mismo: la vuelta toma el primer vecino de la capa d-1 en el orden abajo,
+// arriba, derecha, izquierda, y el BFS se queda con el padre que salió antes
+// de la cola, que depende del orden dentro de la capa y acá no se guarda.
+// La transitabilidad se copia de la grilla en cada búsqueda (H filas de W/64
+// palabras, poco al lado de la búsqueda), así que no hay caché que invalidar
+// cuando cambian los muros.
+//
+// No es una estrategia del juego: en un tablero 4-conexo cada capa tiene muy
+// pocas celdas por fila y las palabras van casi vacías, así que sigue siendo
+// más lento que BFSWorkspace (bench/SolverBench lo compara). Lo que ahorra es
+// memoria, unos 3 bits por celda contra 12 bytes.
+class BitParallelBFS {
+public:
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    // Frente sobre tablero completo: H+2 filas (relleno arriba y abajo) y una
+    // palabra de relleno a cada lado. lo/hi acotan las palabras no nulas de cada fila.
+    struct Layer {
+        std::vector<uint64_t> bits;
+        std::vector<int> lo, hi;
+        int rowMin = 0, rowMax = -1;
+    };
+
+    // Copia compacta de un frente: solo las palabras dentro de lo/hi
+    struct Band {
+        int rowMin = 0, rowMax = -1;
+        std::vector<int> lo, hi, offset;
+        std::vector<uint64_t> words;
+    };
+
+    struct Checkpoint {
+        int layer;
+        Band prev, cur;
+    };
+
+    void build();
+    void clearRow(Layer& layer, int r);
+    void clear(Layer& layer);
+    void seed(int cell);
+    bool step();
+    void save(const Layer& layer, Band& band) const;
+    void load(const Band& band, Layer& layer);
+    bool contains(const Band& band, int cell) const;
+
+    uint64_t* row(Layer& layer, int r) { return layer.bits.data() + (r + 1) * stride + 1; }
+
+    int W = 0, H = 0, words = 0, stride = 0;
+
+    std::vector<uint64_t> open;   // H filas: bit = celda transitable
+    Layer ring[2];                // capa actual y anterior
+    int cur = 0;
+    bool counting = false;
+    std::vector<std::pair<int,int>> spans;
+
+    SolveStats stats;
+};
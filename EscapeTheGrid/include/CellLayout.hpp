@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstdint>
+
+// Órdenes de las celdas en memoria para estructuras indexadas por celda.
+// Todas dan index(x,y), la vuelta x(i)/y(i) y el paso a cada vecino a partir
+// del índice (y de x o y cuando el orden lo necesita), así una búsqueda
+// escrita sobre un Layout no multiplica ni divide en el caso de filas.
+// Las celdas fuera del tablero que el orden necesite como relleno quedan
+// dentro de size() y el que recorre las salta por x,y.
+
+// y*W + x, el orden de siempre
+struct RowMajorLayout {
+    void resize(int w, int h) { W = w; H = h; }
+    int size() const { return W * H; }
+    int index(int x, int y) const { return y * W + x; }
+    int x(int i) const { return i % W; }
+    int y(int i) const { return i / W; }
+
+    int down(int i, int) const { return i + W; }
+    int up(int i, int) const { return i - W; }
+    int right(int i, int) const { return i + 1; }
+    int left(int i, int) const { return i - 1; }
+
+    int W = 0, H = 0;
+};
+
+// Orden Z (Morton): los bits de x e y intercalados, así los vecinos de arriba
+// y abajo suelen quedar cerca de la celda. Con tableros no cuadrados los bits
+// que le sobran a la dimensión más larga van arriba de todo. Los vecinos se
+// calculan con suma enmascarada sobre los bits de x o de y.
+struct MortonLayout {
+    void resize(int w, int h) {
+        int bx = bitsFor(w), by = bitsFor(h);
+        int common = bx < by ? bx : by;
+        xMask = yMask = 0;
+        for (int b = 0; b < common; ++b) {
+            xMask |= 1u << (2 * b);
+            yMask |= 1u << (2 * b + 1);
+        }
+        uint32_t high = ((1u << (bx + by - 2 * common)) - 1) << (2 * common);
+        if (bx > by) xMask |= high;
+        else yMask |= high;
+        shift = 2 * common;
+        cells = 1 << (bx + by);
+        xLonger = bx > by;
+    }
+    int size() const { return cells; }
+    int index(int x, int y) const {
+        uint32_t low = spread(x) | spread(y) << 1;
+        low &= (1u << shift) - 1;
+        uint32_t rest = uint32_t(xLonger ? x : y) >> (shift / 2);
+        return int(low | rest << shift);
+    }
+    int x(int i) const { return int(gather(uint32_t(i), xMask)); }
+    int y(int i) const { return int(gather(uint32_t(i), yMask)); }
+
+    int down(int i, int) const { return inc(i, yMask); }
+    int up(int i, int) const { return dec(i, yMask); }
+    int right(int i, int) const { return inc(i, xMask); }
+    int left(int i, int) const { return dec(i, xMask); }
+
+    uint32_t xMask = 0, yMask = 0;
+    int shift = 0, cells = 0;
+    bool xLonger = false;
+
+private:
+    static int bitsFor(int n) {
+        int b = 0;
+        while ((1 << b) < n) ++b;
+        return b;
+    }
+    // Bit k de v pasa al bit 2k
+    static uint32_t spread(uint32_t v) {
+        v &= 0xFFFF;
+        v = (v | (v << 8)) & 0x00FF00FF;
+        v = (v | (v << 4)) & 0x0F0F0F0F;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+    static uint32_t gather(uint32_t i, uint32_t mask) {
+        uint32_t v = 0;
+        int out = 0;
+        for (uint32_t m = mask; m; m &= m - 1, ++out) {
+            v |= ((i >> __builtin_ctz(m)) & 1) << out;
+        }
+        return v;
+    }
+    static int inc(int i, uint32_t mask) {
+        return int((((uint32_t(i) | ~mask) + 1) & mask) | (uint32_t(i) & ~mask));
+    }
+    static int dec(int i, uint32_t mask) {
+        return int((((uint32_t(i) & mask) - 1) & mask) | (uint32_t(i) & ~mask));
+    }
+};
+
+// Bloques de 2^LOG x 2^LOG celdas en orden de filas, y los bloques también
+// en orden de filas. Con LOG = 3 un bloque de celdas de un byte es una línea
+// de caché de 64 bytes.
+template <int LOG = 3>
+struct TiledLayout {
+    static const int T = 1 << LOG;
+
+    void resize(int w, int h) {
+        W = w;
+        H = h;
+        tilesX = (W + T - 1) / T;
+        tilesY = (H + T - 1) / T;
+    }
+    int size() const { return tilesX * tilesY * T * T; }
+    int index(int x, int y) const {
+        return (((y >> LOG) * tilesX + (x >> LOG)) << (2 * LOG)) | (y & (T - 1)) << LOG | (x & (T - 1));
+    }
+    int x(int i) const { return ((i >> (2 * LOG)) % tilesX) << LOG | (i & (T - 1)); }
+    int y(int i) const { return ((i >> (2 * LOG)) / tilesX) << LOG | ((i >> LOG) & (T - 1)); }
+
+    int down(int i, int y) const { return (y & (T - 1)) != T - 1 ? i + T : i + tilesX * T * T - (T - 1) * T; }
+    int up(int i, int y) const { return (y & (T - 1)) ? i - T : i - tilesX * T * T + (T - 1) * T; }
+    int right(int i, int x) const { return (x & (T - 1)) != T - 1 ? i + 1 : i + T * T - (T - 1); }
+    int left(int i, int x) const { return (x & (T - 1)) ? i - 1 : i - T * T + (T - 1); }
+
+    int W = 0, H = 0;
+    int tilesX = 0, tilesY = 0;
+};
+
+// Orden elegido al compilar: -DETG_CELL_LAYOUT=1 para Morton, 2 para bloques.
+// Sin definirlo es el de filas, que se reduce a y*W + x y i±1, i±W.
+#ifndef ETG_CELL_LAYOUT
+#define ETG_CELL_LAYOUT 0
+#endif
+
+#if ETG_CELL_LAYOUT == 1
+using DefaultLayout = MortonLayout;
+#elif ETG_CELL_LAYOUT == 2
+using DefaultLayout = TiledLayout<>;
+#else
+using DefaultLayout = RowMajorLayout;
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Lo único que necesita un solver, en 2 bits por celda
+enum class CompactCell { Open = 0, Wall = 1, Crystal = 2, Goal = 3 };
+
+// Vista compacta de solo lectura del laberinto para resolver en lote: 32
+// celdas por palabra de 64 bits (un cuarto de la memoria del plano de tipos).
+// Cada fila ocupa runsPerRow() palabras con al menos una celda de relleno al
+// final y hay una fila extra arriba y otra abajo, todas muro; así la celda
+// (x,y) es el índice padded(x,y) y sus vecinos están a ±1 y ±paddedWidth() sin
+// comprobar bordes.
+class CompactGrid {
+public:
+    static const int RUN = 32;   // celdas por palabra
+
+    CompactGrid() = default;
+    explicit CompactGrid(const CellGrid& grid);
+
+    int width() const { return W; }
+    int height() const { return H; }
+    int paddedWidth() const { return stride * RUN; }
+    int padded(int x, int y) const { return (y + 1) * stride * RUN + x; }
+
+    // Vale también para las celdas de relleno (muro)
+    CompactCell at(int c) const { return CompactCell((words[c >> 5] >> ((c & 31) << 1)) & 3); }
+    CompactCell at(int x, int y) const { return at(padded(x, y)); }
+    bool isWall(int c) const { return at(c) == CompactCell::Wall; }
+    bool isWall(int x, int y) const { return isWall(padded(x, y)); }
+
+    void set(int x, int y, CompactCell t);
+
+    // Las 32 celdas desde x = 32*r de la fila y, en una sola lectura
+    uint64_t run(int y, int r) const { return words[(long)(y + 1) * stride + r]; }
+    int runsPerRow() const { return stride; }
+
+    // Bit k = la celda k del tramo es muro / se puede entrar
+    static uint32_t wallBits(uint64_t run) { return evenBits(run & ~(run >> 1)); }
+    static uint32_t openBits(uint64_t run) { return ~wallBits(run); }
+
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+private:
+    // Junta los bits pares de x en los 32 bits bajos
+    static uint32_t evenBits(uint64_t x) {
+        x &= 0x5555555555555555ull;
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+        return uint32_t(x);
+    }
+
+    int W = 0, H = 0;
+    int stride = 0;
+    std::vector<uint64_t> words;
+};
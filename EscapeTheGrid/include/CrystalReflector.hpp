@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MirrorKernel.hpp"
+
+// Reflejos de los cristales mantenidos en forma incremental.
+// Un cristal en (cx,cy) refleja cada celda recorrida de su fila a la izquierda
+// en (2cx - x, cy) y cada una de su columna por encima en (cx, 2cy - y); el
+// reflejo queda recorrido y reflejado si no es muro. Se guarda el plano de
+// "espejadas" (reflejos cuyo origen ya está recorrido), que solo crece, y los
+// reflejados son espejadas & ~muro. Con los cristales indexados por fila y por
+// columna, una celda nueva solo toca los cristales que comparten su fila o
+// columna. Los muros que cambian se aplican en el siguiente paso, igual que
+// cuando se recalculaba todo tras cada movimiento. El primer paso después de
+// reset() hace el recalculo completo con MirrorKernel.
+class CrystalReflector {
+public:
+    // Tras cargar o reiniciar: se reindexa en el próximo paso
+    void reset() { built = false; pending.clear(); }
+
+    // Celda que cambió de muro a vacía o al revés
+    void cellChanged(int x, int y);
+
+    // Marca (x,y) como recorrida y actualiza reflejos
+    void traverse(CellGrid& grid, int x, int y);
+
+    // Tras volver a un turno del historial; 'changes' es lo que reescribió
+    // TurnHistory::jumpTo(). La grilla ya tiene las marcas de ese turno y solo
+    // falta el plano de espejadas: los reflejos de cada celda que cambió de
+    // recorrida se recalculan desde sus orígenes posibles. El muro del evento
+    // de ese turno, que todavía no pasó por los reflejos, se pasa después con
+    // cellChanged()
+    void turnRestored(const CellGrid& grid, const std::vector<CellChange>& changes);
+
+    // Cristales revisados en el último paso
+    int lastWork() const { return work; }
+
+private:
+    void build(CellGrid& grid);
+    void visit(CellGrid& grid, int cell);
+    void mirror(CellGrid& grid, int cell);
+    void drain(CellGrid& grid);
+    bool hasSource(const CellGrid& grid, int cell) const;
+    void recheckTargets(const CellGrid& grid, int cell);
+
+    bool built = false;
+    int W = 0, H = 0;
+    int work = 0;
+    std::vector<std::vector<int>> rowCrystals;   // x de los cristales de cada fila, ordenadas
+    std::vector<std::vector<int>> colCrystals;   // y de los cristales de cada columna, ordenadas
+    std::vector<uint64_t> mirrored;
+    MirrorKernel kernel;
+    std::vector<int> pending;
+    std::vector<int> stack;
+};
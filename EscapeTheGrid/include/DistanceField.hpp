@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Campo de distancias hasta la meta (BFS inverso) en un arreglo plano.
+// Con él, el siguiente paso óptimo desde cualquier celda sale en O(1): el
+// vecino con menor distancia. Solo se reconstruye cuando alguien lo marca
+// como sucio (moveGoal(), triggerMapEvent(), reinicio).
+class DistanceField {
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    void markDirty() { dirty = true; }
+
+    // Reconstruye el campo si está sucio. Devuelve true si lo reconstruyó.
+    bool update(const CellGrid& grid, int W, int H, int goalX, int goalY);
+
+    uint32_t distance(int x, int y) const { return dist[y*W + x]; }
+
+    // Siguiente celda de un camino mínimo desde (x,y).
+    // Devuelve false si ya está en la meta o si la meta es inalcanzable.
+    bool nextStep(const CellGrid& grid, int x, int y, int& nextX, int& nextY) const;
+
+private:
+    bool dirty = true;
+    int W = 0, H = 0;
+    int goal = -1;
+    std::vector<uint32_t> dist;
+    std::vector<int32_t> queue;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Conjunto de celdas vacías (CellType::Empty) para reubicar la meta en O(1).
+// Las celdas están en un arreglo denso y 'slot' guarda la posición de cada una
+// (-1 si no está); borrar mueve la última al hueco. Después de rebuild() no se
+// reserva memoria: el arreglo denso ya tiene capacidad para todo el tablero.
+class FreeCellSet {
+public:
+    void rebuild(const CellGrid& grid);
+
+    void insert(int cell);
+    void erase(int cell);
+    bool contains(int cell) const { return slot[cell] >= 0; }
+    int size() const { return (int)cells.size(); }
+
+    // Celda al azar del conjunto distinta de 'excluded', o -1 si no hay.
+    // Usa un mt19937 propio: rand() llega solo a 32767 con MinGW y en un
+    // tablero grande dejaría fuera casi todas las celdas
+    int pick(int excluded);
+
+private:
+    std::vector<int32_t> cells;
+    std::vector<int32_t> slot;
+    std::mt19937 rng;
+};
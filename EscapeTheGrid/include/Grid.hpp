@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// ==================== TIPOS DE CELDA ====================
+enum class CellType { Empty, Wall, Start, Goal, Crystal };
+
+// Marcas de estado por celda, cada una en su propio plano de bits
+enum class CellFlag { Visited, OnPath, Traversed, Reflected };
+
+// Cambio registrado por el diario de la grilla: plano 0 es el tipo y 1 + f la
+// marca f; 'before' es el valor que tenía la celda antes del cambio
+struct CellChange {
+    int32_t cell;
+    uint8_t plane;
+    uint8_t before;
+};
+
+// Tablero en estructura de arreglos: el tipo de cada celda en un plano de
+// uint8 y cada marca en un plano de bits aparte (1.5 bytes por celda, 2.1 con
+// la transitabilidad de abajo; bench/GridBench lo mide).
+// Limpiar una marca es un memset de W*H/8 bytes y un recorrido solo toca el
+// plano que necesita. Las celdas se indexan como y*W + x.
+//
+// setType() mantiene además la transitabilidad (no muro) de dos formas:
+//  - un tablero de bits donde cada fila ocupa openRowWords() palabras, con al
+//    menos un bit en cero después de x = W-1 y una fila en cero arriba y otra
+//    abajo, para consultas de 64 celdas por vez y sin comprobar bordes;
+//  - 4 bits por celda con los vecinos a los que se puede entrar desde ella, así
+//    la consulta de vecinos de un BFS es una sola lectura.
+class CellGrid {
+public:
+    static const int FLAG_COUNT = 4;
+
+    // Todas las celdas quedan vacías y sin marcas
+    void resize(int W, int H);
+
+    int width() const { return W; }
+    int height() const { return H; }
+    int size() const { return W * H; }
+
+    CellType type(int i) const { return CellType(types[i]); }
+    void setType(int i, CellType t);
+    bool isWall(int i) const { return types[i] == uint8_t(CellType::Wall); }
+
+    // Se puede entrar a (x,y). Vale también una celda fuera del tablero (falso)
+    bool passable(int x, int y) const { return openBit(openIndex(x, y)); }
+
+    // Vecinos a los que se puede entrar desde la celda i, en el orden de
+    // siempre: bit 0 abajo (i+W), 1 arriba (i-W), 2 derecha (i+1), 3 izquierda (i-1)
+    int passableMask(int i) const { return (neighbors[i >> 1] >> ((i & 1) << 2)) & 15; }
+
+    // Palabras de transitabilidad de la fila y (64 celdas por palabra)
+    const uint64_t* openRow(int y) const { return open.data() + (long)(y + 1) * openStride; }
+    int openRowWords() const { return openStride; }
+
+    bool has(CellFlag f, int i) const { return (planes[int(f)][i >> 6] >> (i & 63)) & 1; }
+    void set(CellFlag f, int i) {
+        if (has(f, i)) return;
+        if (journal && f >= CellFlag::Traversed) journal->push_back({i, uint8_t(1 + int(f)), 0});
+        planes[int(f)][i >> 6] |= 1ull << (i & 63);
+        touch(i);
+    }
+    void reset(CellFlag f, int i) {
+        if (!has(f, i)) return;
+        if (journal && f >= CellFlag::Traversed) journal->push_back({i, uint8_t(1 + int(f)), 1});
+        planes[int(f)][i >> 6] &= ~(1ull << (i & 63));
+        touch(i);
+    }
+    void clear(CellFlag f);
+
+    // Diario de cambios: con uno puesto, setType() y set()/reset() de
+    // Traversed y Reflected agregan cada cambio efectivo. Visited y OnPath son
+    // de cada búsqueda y no se registran, igual que clear()
+    void setJournal(std::vector<CellChange>* j) { journal = j; }
+
+    // Celdas tocadas, para redibujar solo eso. Con trackChanges(true) cada
+    // cambio efectivo de tipo o de cualquier marca anota la celda una vez;
+    // clear() cuenta como todo el tablero.
+    // takeChanges() deja las anotadas en 'cells' (y las olvida) y devuelve
+    // true si hay que tomar todo el tablero como cambiado
+    void trackChanges(bool on);
+    bool takeChanges(std::vector<int>& cells);
+
+    // Acceso directo a los planos para recorridos en bloque, solo de lectura:
+    // las escrituras pasan por set()/reset() para el diario y los cambios
+    const uint8_t* typeData() const { return types.data(); }
+    const uint64_t* flagData(CellFlag f) const { return planes[int(f)].data(); }
+    int flagWords() const { return (int)planes[0].size(); }
+
+private:
+    long openIndex(int x, int y) const { return (long)(y + 1) * openStride * 64 + x; }
+    int openBit(long b) const { return (open[b >> 6] >> (b & 63)) & 1; }
+    void touch(int i) {
+        if (!tracking || (touchedBits[i >> 6] >> (i & 63)) & 1) return;
+        touchedBits[i >> 6] |= 1ull << (i & 63);
+        touched.push_back(i);
+    }
+
+    int W = 0, H = 0;
+    int openStride = 0;
+    std::vector<uint8_t> types;
+    std::vector<uint64_t> open;
+    std::vector<uint8_t> neighbors;   // dos celdas por byte
+    std::vector<uint64_t> planes[FLAG_COUNT];
+    std::vector<CellChange>* journal = nullptr;
+    bool tracking = false;
+    bool allTouched = true;
+    std::vector<uint64_t> touchedBits;
+    std::vector<int> touched;
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Versión de lejos del tablero para cuando una celda mide menos de un píxel.
+// El nivel base tiene un texel por bloque de 2^shift x 2^shift celdas con el
+// promedio de sus colores (shift lo más chico que deje el base en BASE_TEXELS)
+// y está partido en texturas de TILE x TILE con mipmaps, que dan los niveles
+// más gruesos. Una celda que cambia solo rehace su texel y sube el rectángulo
+// tocado de su bloque.
+class GridLod {
+public:
+    static const int BASE_TEXELS = 1 << 24;
+    static const int TILE = 1024;
+
+    void build(const CellGrid& grid, float cellSize);
+    void reset() { tiles.clear(); pixels.clear(); dirty.clear(); }
+    bool built() const { return !tiles.empty(); }
+
+    void cellChanged(int cell);
+    void invalidate() { stale = true; }
+    void update(const CellGrid& grid);
+    void draw(sf::RenderTarget& target, const sf::FloatRect& visible) const;
+
+private:
+    struct Tile {
+        sf::Texture texture;
+        int x0 = 0, y0 = 0, w = 0, h = 0;        // texels del nivel base
+        int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = 0, dirtyY1 = 0;   // por subir (vacío si x0 >= x1)
+    };
+
+    void paintTexel(const CellGrid& grid, int tx, int ty);
+    void markTexel(int tx, int ty);
+
+    int W = 0, H = 0;
+    int shift = 0;
+    int BW = 0, BH = 0;          // tamaño del nivel base en texels
+    int tilesX = 0, tilesY = 0;
+    float cellSize = 0;
+    bool stale = false;
+    std::vector<uint8_t> pixels;   // nivel base RGBA
+    std::vector<Tile> tiles;
+    std::vector<int> dirty;        // texels por repintar
+    std::vector<uint8_t> marked;
+    std::vector<uint8_t> scratch;
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+#include "GridLod.hpp"
+#include "GridShader.hpp"
+
+// Dibujo del tablero en una sola llamada: todos los triángulos de las celdas
+// en un sf::VertexArray de sf::Triangles. La geometría (la misma que daba un
+// sf::ConvexShape por celda, con su contorno de 0.5 y el triángulo extra de
+// los cristales, en el mismo orden) se arma una vez y después solo cambian
+// los colores de relleno.
+//
+// Solo se arma la ventana de celdas que cubre lo visible más un margen, así
+// el costo por cuadro depende del tamaño de la pantalla y no del mapa; la
+// ventana se rearma cuando la vista se sale de ella. Cuando una celda mide
+// menos de un píxel se dibuja en cambio GridLod, que se arma la primera vez
+// que hace falta y desde ahí recibe también las celdas cambiadas. Con
+// useShader() se dibuja en cambio con GridShader, que recibe los cambios de
+// la misma forma; sin shaders queda este camino.
+//
+// Si la placa lo permite, la malla vive además en un sf::VertexBuffer en la
+// GPU. update() toma de la grilla las celdas que cambiaron desde el cuadro
+// anterior (CellGrid::takeChanges), reescribe sus colores de relleno y sube
+// solo esos rangos de vértices, juntando los que están cerca. Sin
+// VertexBuffer (GL sin VBO, software) se dibuja el VertexArray.
+class GridRenderer {
+public:
+    // Con más celdas que esto en la ventana no se arma el contorno: mide mucho
+    // menos de un píxel y multiplicaría por 7 los vértices
+    static const int OUTLINE_LIMIT = 256 * 256;
+    // Rangos a menos de esto se suben juntos
+    static const int MERGE_GAP = 256;
+    // Con más celdas visibles se usa GridLod aunque midan más de un píxel
+    static const int GEOMETRY_LIMIT = 1 << 22;
+    // Tope de celdas visibles con allowLod(false), unos 700 MB de vértices;
+    // arriba se usa GridLod igual
+    static const int MEASURE_GEOMETRY_LIMIT = 1 << 24;
+
+    // Tablero nuevo; activa el registro de cambios de la grilla
+    void build(CellGrid& grid, float cellSize);
+    // Para la vista que tiene puesta 'target'
+    void update(CellGrid& grid, const sf::RenderTarget& target);
+    void draw(sf::RenderTarget& target) const;
+
+    bool usingLod() const { return lodMode; }
+    // Con false se dibujan triángulos aunque las celdas midan menos de un
+    // píxel, para comparar el tiempo por cuadro con GridLod
+    void allowLod(bool on) { lodAllowed = on; }
+    // false si se pidió el shader y no se pudo armar
+    bool useShader(const CellGrid& grid, bool on);
+    bool usingShader() const { return shaderMode; }
+
+    // Vértices subidos a la GPU en el último update()
+    int lastUpload() const { return uploaded; }
+    // Celdas con geometría armada
+    int windowCells() const { return ww * wh; }
+
+    static sf::Color cellColor(CellType type, int x, int y, bool visited, bool traversed, bool reflected);
+
+private:
+    void buildWindow(const CellGrid& grid, int x0, int y0, int x1, int y1);
+    void addCell(int x, int y, bool crystal);
+    void addShape(const sf::Vector2f* points, sf::Color fill);
+    bool paint(const CellGrid& grid, int x, int y);
+    void upload(int first, int count);
+
+    int W = 0, H = 0;
+    float cellSize = 0;
+    bool outlines = true;
+    int wx = 0, wy = 0, ww = 0, wh = 0;   // ventana armada: origen y tamaño en celdas
+    sf::VertexArray vertices{sf::Triangles};
+    sf::VertexBuffer buffer{sf::Triangles, sf::VertexBuffer::Static};
+    bool bufferReady = false;
+    bool repaint = false;   // la ventana entera necesita colores (y subirse)
+    int uploaded = 0;
+    std::vector<int> dirty;
+    std::vector<int> firstVertex;   // primer vértice del relleno de cada celda de la ventana
+    std::vector<uint8_t> crystal;   // la celda era cristal al armar la geometría
+    GridLod lod;
+    bool lodMode = false;
+    bool lodAllowed = true;
+    GridShader shader;
+    bool shaderMode = false;
+    sf::FloatRect visible;
+};
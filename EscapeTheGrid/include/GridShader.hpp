@@ -0,0 +1,49 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Dibujo del tablero en la placa: el estado de cada celda va en un texel de
+// una textura RGBA8 (tipo, visitada, recorrida, reflejada) y un fragment
+// shader arma los triángulos, sus contornos y los colores de
+// GridRenderer::cellColor. Dibujar es un solo cuadrilátero sobre lo visible,
+// sin importar cuántas celdas tenga, y una celda que cambia sube solo su
+// texel (junto con las vecinas de la misma fila si están cerca). Con celdas
+// de menos de un píxel toma una sola celda por píxel, sin promediar como
+// GridLod.
+class GridShader {
+public:
+    // Filas por subida al rehacer la textura entera
+    static const int BAND = 256;
+    // Celdas cercanas de una fila a menos de esto se suben juntas
+    static const int MERGE_GAP = 64;
+
+    // false (y avisa) si no hay shaders o el tablero no entra en una textura
+    bool build(const CellGrid& grid, float cellSize);
+    void reset() { ready = false; dirty.clear(); }
+    bool built() const { return ready; }
+
+    void cellChanged(int cell);
+    void invalidate() { stale = true; }
+    void update(const CellGrid& grid, bool outlines);
+    void draw(sf::RenderTarget& target, const sf::FloatRect& visible) const;
+
+    // Texels subidos en el último update()
+    int lastUpload() const { return uploaded; }
+
+private:
+    void encode(const CellGrid& grid, int cell, uint8_t* texel) const;
+
+    int W = 0, H = 0;
+    float cellSize = 0;
+    bool ready = false;
+    bool stale = false;
+    int uploaded = 0;
+    sf::Texture state;
+    sf::Shader shader;
+    std::vector<int> dirty;
+    std::vector<uint8_t> scratch;
+};
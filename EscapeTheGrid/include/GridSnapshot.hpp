@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Versión inmutable de los tipos de celda del laberinto, compartible entre
+// hilos sin bloqueos. Las celdas están en bloques de TILE x TILE con conteo de
+// referencias: una versión nueva copia la tabla de bloques y solo los bloques
+// que cambian (copia en escritura); el resto se comparte con la anterior. Quien
+// tenga una versión la sigue leyendo igual aunque el juego publique otras.
+class GridSnapshot {
+public:
+    static const int TILE = 64;   // type() depende de que sea 64
+
+    GridSnapshot() = default;
+    explicit GridSnapshot(const CellGrid& grid);
+
+    int width() const { return W; }
+    int height() const { return H; }
+    uint64_t version() const { return serial; }
+
+    CellType type(int x, int y) const {
+        return CellType(tiles[(y >> 6) * tilesX + (x >> 6)]->types[(y & 63) << 6 | (x & 63)]);
+    }
+    bool isWall(int x, int y) const { return type(x, y) == CellType::Wall; }
+    bool isWall(int cell) const { return isWall(cell % W, cell / W); }
+
+    // Nueva versión con los cambios (índice y*W + x, tipo) aplicados
+    GridSnapshot withTypes(const std::vector<std::pair<int, CellType>>& changes) const;
+    GridSnapshot withType(int cell, CellType t) const { return withTypes({{cell, t}}); }
+
+    // Bloques que esta versión comparte con otra (para medir la copia en escritura)
+    int sharedTiles(const GridSnapshot& other) const;
+
+private:
+    struct Tile {
+        uint8_t types[TILE * TILE];
+    };
+
+    int W = 0, H = 0;
+    int tilesX = 0, tilesY = 0;
+    uint64_t serial = 0;
+    std::vector<std::shared_ptr<const Tile>> tiles;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BFS.hpp"
+#include "Grid.hpp"
+
+// Búsqueda jerárquica (HPA*) para laberintos muy grandes.
+// El tablero se divide en grupos de CLUSTER x CLUSTER celdas. En cada borde
+// entre dos grupos se colocan entradas (una por tramo libre, dos si el tramo
+// es largo) y dentro de cada grupo se precalculan las distancias entre sus
+// entradas. La búsqueda corre sobre ese grafo abstracto y solo se refinan los
+// grupos por los que pasa la ruta. El camino es casi óptimo, no siempre mínimo.
+class HierarchicalPlanner {
+public:
+    static const int CLUSTER = 32;
+
+    void invalidate();
+    void cellChanged(int x, int y);
+
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    struct Cluster {
+        int x0, y0, x1, y1;                     // celdas [x0,x1) x [y0,y1)
+        std::vector<int> nodes;                 // entradas (índice de celda), ordenadas
+        std::vector<std::vector<int>> partners; // entrada del grupo vecino, por nodo
+        std::vector<int> dist;                  // nodes x nodes, -1 = no se llega por dentro
+    };
+
+    void build(const CellGrid& grid);
+    void buildBorder(const CellGrid& grid, int cluster, bool east);
+    void buildCluster(const CellGrid& grid, int cluster);
+    int clusterOf(int cell) const;
+    int localNode(const Cluster& cluster, int cell) const;
+    int toLocal(const Cluster& cluster, int cell) const;
+    int fromLocal(const Cluster& cluster, int local) const;
+    void clusterDistances(const CellGrid& grid, Cluster& cluster);
+    void loadCluster(const CellGrid& grid, const Cluster& cluster);
+    void localSearch(const Cluster& cluster, int source);
+    int localDistance(const Cluster& cluster, int cell) const;
+    void appendLocalPath(const CellGrid& grid, int from, int to,
+                         std::vector<std::pair<int,int>>& path);
+
+    bool built = false;
+    int W = 0, H = 0, CW = 0, CH = 0;
+    std::vector<int> pending;
+
+    // Pares (celda de este grupo, celda del vecino) en el borde este y sur de cada grupo
+    std::vector<std::vector<std::pair<int,int>>> eastBorder, southBorder;
+    std::vector<Cluster> clusters;
+
+    // BFS local acotado a un grupo, sobre una copia con marco de muros
+    static const int STRIDE = CLUSTER + 2;
+    std::vector<char> localOpen;
+    int nodeAt[CLUSTER * CLUSTER];
+    std::vector<int> localDist, localParent, localQueue;
+
+    // Estado de la búsqueda abstracta, marcado por época
+    uint32_t epoch = 0;
+    std::vector<uint32_t> seen, closed;
+    std::vector<int> g, parent;
+
+    SolveStats stats;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Planificador incremental (D* Lite) para el modo automático.
+// La búsqueda parte de la meta, conserva g/rhs entre llamadas y solo
+// repara la zona afectada por las celdas que cambian, por el avance del
+// jugador o por el movimiento de la meta.
+class IncrementalPlanner {
+public:
+    // Descarta el estado (nuevo laberinto o reinicio)
+    void invalidate();
+
+    // Registra una celda que cambió de tipo (muro <-> vacío)
+    void cellChanged(int x, int y);
+
+    // Calcula el camino (y,x) desde el inicio hasta la meta, ambos incluidos.
+    // Devuelve false si la meta es inalcanzable.
+    bool replan(const CellGrid& grid, int W, int H,
+                int startX, int startY, int goalX, int goalY,
+                std::vector<std::pair<int,int>>& path);
+
+    // Nodos expandidos en la última llamada a replan()
+    int lastExpanded() const { return expanded; }
+
+private:
+    using Key = std::pair<int,int>;
+    struct Entry {
+        Key key;
+        int cell;
+        bool operator>(const Entry& o) const { return key > o.key; }
+    };
+
+    void initialize(int W, int H, int start, int goal);
+    int heuristic(int a, int b) const;
+    Key calculateKey(int s) const;
+    void updateVertex(const CellGrid& grid, int u);
+    void computeShortestPath(const CellGrid& grid);
+
+    bool initialized = false;
+    int W = 0, H = 0;
+    int start = -1, goal = -1, lastStart = -1;
+    int km = 0;
+    int expanded = 0;
+    std::vector<int> g, rhs;
+    std::vector<int> pending;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "AStar.hpp"
+#include "BFS.hpp"
+#include "Grid.hpp"
+
+// Jump Point Search para la cuadrícula de 4 direcciones.
+// Orden canónico: primero horizontal, luego vertical. Un salto horizontal
+// lanza saltos verticales en cada celda; un salto vertical solo se detiene en
+// la meta o donde aparece un vecino forzado (lateral libre cuyo anterior es muro).
+// Solo los muros bloquean; los cristales se atraviesan como en bfsSolve().
+// El camino devuelto se expande celda por celda.
+class JumpPointSearch {
+public:
+    void resize(int W, int H);
+
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    bool blocked(int x, int y) const;
+    int jumpVertical(int x, int y, int dy) const;
+    int jumpHorizontal(int x, int y, int dx) const;
+    void push(int from, int to, int8_t dx, int8_t dy);
+
+    const CellGrid* grid = nullptr;
+    int W = 0, H = 0;
+    int goalX = 0, goalY = 0;
+
+    uint32_t epoch = 0;
+    std::vector<uint32_t> seen;
+    std::vector<uint32_t> closed;
+    std::vector<int32_t> g;
+    std::vector<int32_t> parent;
+    std::vector<int8_t> arrivalX, arrivalY;   // dirección con la que se llegó
+    BucketQueue open;
+    SolveStats stats;
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BFS.hpp"
+#include "CellLayout.hpp"
+#include "Grid.hpp"
+
+// Transitabilidad del laberinto (un byte por celda) guardada en el orden de
+// celdas de Layout. Solo lectura: se arma de nuevo desde la grilla.
+template <class Layout = DefaultLayout>
+class LayoutGrid {
+public:
+    LayoutGrid() = default;
+
+    explicit LayoutGrid(const CellGrid& grid) : W(grid.width()), H(grid.height()) {
+        cells.resize(W, H);
+        open.assign(cells.size(), 0);
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                open[cells.index(x, y)] = !grid.isWall(y*W + x);
+            }
+        }
+    }
+
+    int width() const { return W; }
+    int height() const { return H; }
+    const Layout& layout() const { return cells; }
+    int index(int x, int y) const { return cells.index(x, y); }
+
+    // Sin comprobar bordes: i tiene que ser una celda del tablero
+    bool passable(int i) const { return open[i]; }
+
+private:
+    int W = 0, H = 0;
+    Layout cells;
+    std::vector<uint8_t> open;
+};
+
+// El BFS de BFSWorkspace escrito sobre un Layout: marcas, padres y la grilla
+// quedan en ese orden y los vecinos salen de los pasos del Layout. La cola
+// lleva también x,y para los bordes y para los órdenes que los necesitan.
+template <class Layout = DefaultLayout>
+class LayoutBFS {
+public:
+    bool solve(const LayoutGrid<Layout>& grid, int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path) {
+        auto t0 = std::chrono::steady_clock::now();
+        stats = SolveStats();
+        const Layout& L = grid.layout();
+        int W = grid.width(), H = grid.height();
+        if ((int)stamp.size() != L.size()) {
+            stamp.assign(L.size(), 0);
+            parent.assign(L.size(), -1);
+            queue.assign(L.size(), Item());
+            epoch = 0;
+            stats.allocations += 3;
+        }
+        path.clear();
+
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+
+        int start = L.index(startX, startY);
+        int goal = L.index(goalX, goalY);
+        int head = 0, tail = 0;
+        queue[tail++] = {start, startX, startY};
+        stamp[start] = epoch;
+        parent[start] = -1;
+
+        auto push = [&](int v, int x, int y, int u) {
+            if (!grid.passable(v) || stamp[v] == epoch) return;
+            stamp[v] = epoch;
+            parent[v] = u;
+            queue[tail++] = {v, x, y};
+        };
+
+        bool found = false;
+        while (head < tail) {
+            Item it = queue[head++];
+            int u = it.cell;
+            if (u == goal) {
+                found = true;
+                break;
+            }
+            // Abajo, arriba, derecha, izquierda, como los demás solvers
+            if (it.y + 1 < H) push(L.down(u, it.y), it.x, it.y + 1, u);
+            if (it.y > 0) push(L.up(u, it.y), it.x, it.y - 1, u);
+            if (it.x + 1 < W) push(L.right(u, it.x), it.x + 1, it.y, u);
+            if (it.x > 0) push(L.left(u, it.x), it.x - 1, it.y, u);
+        }
+        stats.expanded = head;
+
+        if (found) {
+            for (int c = goal; c != -1; c = parent[c]) {
+                path.push_back({L.y(c), L.x(c)});
+            }
+            std::reverse(path.begin(), path.end());
+        }
+
+        stats.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        return found;
+    }
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    struct Item {
+        int cell, x, y;
+    };
+
+    uint32_t epoch = 0;
+    std::vector<uint32_t> stamp;
+    std::vector<int32_t> parent;
+    std::vector<Item> queue;
+    SolveStats stats;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+#include "Grid.hpp"
+
+// Dimensiones, inicio y meta de un laberinto leído de archivo
+struct MazeInfo {
+    int W = 0, H = 0;
+    int startX = 0, startY = 0;
+    int goalX = 0, goalY = 0;
+};
+
+// Formato de assets/maze.txt: "W H", "inicioY inicioX", "metaY metaX" y
+// después H filas de W celdas separadas por espacios (# muro, S inicio,
+// G meta, C o K cristal, cualquier otra cosa vacía). Devuelve false (y
+// avisa) si el archivo no se puede abrir o está incompleto.
+bool loadMazeFile(const std::string& path, CellGrid& grid, MazeInfo& maze);
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Recalculo completo de los reflejos de cristales con planos de bits.
+// Lo recorrido y los muros se guardan por filas y por columnas (transpuestas),
+// cada uno también con los bits invertidos. El reflejo de un cristal sobre su
+// fila es la fila invertida desplazada, así que se calcula de a 64 celdas
+// (256 con AVX2) en vez de una distancia por vez. Los cristales se recorren en
+// orden de filas, igual que la pasada original, y el resultado es idéntico.
+class MirrorKernel {
+public:
+    // rowCrystals[y]: x de los cristales de la fila y, ordenadas.
+    // Deja Traversed y Reflected en grid y los reflejos cuyo origen está
+    // recorrido (sean muro o no) en 'mirrored', un plano de bits y*W + x.
+    void run(CellGrid& grid, const std::vector<std::vector<int>>& rowCrystals,
+             std::vector<uint64_t>& mirrored);
+
+private:
+    void setTraversed(int x, int y);
+
+    int W = 0, H = 0;
+    int rowWords = 0, colWords = 0;   // palabras por fila y por columna
+    // Planos con una palabra de guarda a cada lado (ver MirrorKernel.cpp)
+    std::vector<uint64_t> openRows, openCols;
+    std::vector<uint64_t> rows, rowsRev, cols, colsRev;
+    std::vector<uint64_t> reflectedRows, mirroredRows;
+    std::vector<uint64_t> span;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "BFS.hpp"
+#include "Grid.hpp"
+#include "ThreadPool.hpp"
+
+// BFS por niveles repartido entre los hilos de un ThreadPool, para laberintos
+// de decenas de millones de celdas. Cada hilo toma un trozo del frente actual,
+// reclama celdas con un fetch_or atómico sobre un mapa de bits de visitadas y
+// escribe su parte del siguiente frente en una lista propia; al final del nivel
+// las listas se concatenan. Solo se guarda el nivel de cada celda: el camino se
+// reconstruye desde la meta eligiendo siempre el vecino del nivel anterior con
+// menor índice, así que el resultado no depende del reparto entre hilos.
+class ParallelBFS {
+public:
+    explicit ParallelBFS(ThreadPool& pool) : pool(pool) {}
+
+    bool solve(const CellGrid& grid, int W, int H,
+               int startX, int startY, int goalX, int goalY,
+               std::vector<std::pair<int,int>>& path);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    void resize(int W, int H);
+
+    ThreadPool& pool;
+    int W = 0, H = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> visited;
+    std::vector<int32_t> level;
+    std::vector<int32_t> frontier, next;
+    std::vector<std::vector<int32_t>> local;   // siguiente frente de cada hilo
+    SolveStats stats;
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BFS.hpp"
+#include "GridSnapshot.hpp"
+#include "ThreadPool.hpp"
+
+struct PathQuery {
+    int startX, startY, goalX, goalY;
+};
+
+// Longitudes de caminos mínimos para muchos pares (inicio, meta) sobre un
+// mismo GridSnapshot. Las consultas se agrupan por inicio: cada grupo es un
+// único BFS que se detiene al alcanzar todas sus metas. Los grupos se reparten
+// en el ThreadPool y cada hilo usa su propio espacio de trabajo.
+// Con un solo hilo y una consulta por inicio es más lento que un
+// BFSWorkspace::solve por consulta (cada lectura del snapshot pasa por la
+// tabla de bloques); lo que gana es compartir el BFS entre metas del mismo
+// inicio y repartir los grupos entre núcleos (bench/QueryBench lo mide).
+class PathQueries {
+public:
+    explicit PathQueries(ThreadPool& pool) : pool(pool) {}
+
+    // lengths[i] = pasos del camino mínimo de queries[i], -1 si no hay camino
+    void solve(const GridSnapshot& grid, const PathQuery* queries, size_t count, int* lengths);
+    void solve(const GridSnapshot& grid, const std::vector<PathQuery>& queries, std::vector<int>& lengths);
+
+    const SolveStats& lastStats() const { return stats; }
+
+private:
+    struct Workspace {
+        uint32_t epoch = 0;
+        std::vector<uint32_t> stamp, target;
+        std::vector<int32_t> dist, queue;
+        int expanded = 0;
+        int allocations = 0;
+    };
+
+    void solveGroup(const GridSnapshot& grid, const PathQuery* queries, const int* members,
+                    int count, int* lengths, Workspace& ws);
+
+    ThreadPool& pool;
+    std::vector<Workspace> workspaces;
+    std::vector<int> order, groups;
+    SolveStats stats;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Grupo fijo de hilos para repartir trabajo por índices.
+// run() reparte las tareas [0, tasks) entre los hilos (el que llama también
+// trabaja) y vuelve cuando todas terminaron. Cada tarea recibe además el
+// número de hilo, útil para indexar espacios de trabajo por hilo.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Hilos que pueden ejecutar tareas a la vez, incluido el que llama
+    int size() const { return (int)workers.size() + 1; }
+
+    void run(int tasks, const std::function<void(int task, int thread)>& fn);
+
+private:
+    void workerLoop(int thread);
+    void drain(int thread);
+
+    std::vector<std::thread> workers;
+    std::mutex guard;
+    std::condition_variable wake, done;
+    bool stopping = false;
+    unsigned generation = 0;
+    int busy = 0;
+
+    // Trabajo en curso
+    const std::function<void(int,int)>* job = nullptr;
+    int jobTasks = 0;
+    std::atomic<int> nextTask{0};
+};
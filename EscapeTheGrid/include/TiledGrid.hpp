@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Grid.hpp"
+
+// Tablero en disco dividido en bloques de TILE x TILE celdas (un byte por
+// celda, el CellType) para laberintos que no entran en memoria. Los bloques se
+// leen al primer acceso y se guardan en un caché LRU de tamaño acotado; al
+// desalojar un bloque modificado se escribe de vuelta en el archivo.
+//
+// Formato: cabecera (ver TiledGrid.cpp) seguida de los bloques en orden de
+// filas de bloques; los del borde se rellenan con muro hasta TILE x TILE.
+// open() comprueba la cabecera y que el archivo tenga todos los bloques. Si
+// después falla una lectura o escritura se avisa, failed() queda en true y un
+// bloque que no se pudo leer queda en muro, nunca con basura.
+//
+// El juego sigue jugando sobre CellGrid; bench/TiledBench recorre un tablero
+// grande con memoria acotada y tests/TiledGridTest prueba el formato.
+class TiledGrid {
+public:
+    static const int TILE = 64;
+
+    ~TiledGrid() { close(); }
+
+    // Abre un archivo ya convertido; memoryBudget acota los bytes de bloques en memoria
+    bool open(const std::string& path, size_t memoryBudget);
+    // Escribe lo pendiente y cierra; false si alguna escritura falló
+    bool close();
+
+    int width() const { return W; }
+    int height() const { return H; }
+    int startX() const { return sx; }
+    int startY() const { return sy; }
+    int goalX() const { return gx; }
+    int goalY() const { return gy; }
+
+    CellType type(int x, int y);
+    void setType(int x, int y, CellType t);
+
+    // Escribe al archivo los bloques modificados; false si alguna escritura falló
+    bool flush();
+    bool failed() const { return ioFailed; }
+
+    size_t residentBytes() const { return (size_t)used * TILE * TILE; }
+    long long tileLoads() const { return loads; }
+
+    // Convierte un laberinto de texto (formato de loadMaze()) al formato por
+    // bloques, leyendo TILE filas por vez
+    static bool convert(const std::string& textPath, const std::string& tiledPath);
+
+private:
+    // Bloque en memoria, enlazado en la lista LRU (head = más reciente)
+    struct Slot {
+        int tile = -1;
+        int prev = -1, next = -1;
+        bool dirty = false;
+        std::vector<uint8_t> cells;
+    };
+
+    uint8_t* cell(int x, int y, bool write);
+    int acquire(int tile);
+    void unlink(int s);
+    void pushFront(int s);
+    bool readTile(Slot& slot);
+    bool writeTile(const Slot& slot);
+    void report(const std::string& message);
+
+    std::fstream file;
+    int W = 0, H = 0, sx = 0, sy = 0, gx = 0, gy = 0;
+    int tilesX = 0, tilesY = 0;
+    std::vector<int32_t> slotOf;   // bloque -> slot, -1 si no está en memoria
+    std::vector<Slot> slots;
+    int used = 0;
+    int head = -1, tail = -1;
+    int lastTile = -1, lastSlot = -1;
+    long long loads = 0;
+    bool ioFailed = false;
+};
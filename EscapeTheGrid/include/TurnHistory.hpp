@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Grid.hpp"
+#include "GridSnapshot.hpp"
+
+// Lo que cambia de un turno a otro fuera de la grilla
+struct TurnState {
+    int playerX = 0, playerY = 0;
+    int goalX = 0, goalY = 0;
+    int turnCount = 0;
+    int turnsSinceLastGoalMove = 0;
+    // Celda que el evento del turno cambió entre muro y vacío (-1 si no hubo);
+    // sus reflejos se ponen al día recién en el paso siguiente
+    int eventCell = -1;
+};
+
+// Historial de turnos para deshacer y rehacer. Cada turno guarda solo las
+// celdas que cambiaron (tipo, Traversed, Reflected) con el valor de antes y el
+// de después, tomadas del diario de la grilla, más su TurnState. Cada
+// CHECKPOINT_INTERVAL turnos se guarda un estado completo que comparte con el
+// anterior todo lo que no cambió (tipos en un GridSnapshot y las marcas en
+// bloques con conteo de referencias), así la memoria crece con los cambios y
+// no con el tamaño del tablero. Ir a un turno lejano parte del punto de
+// control más cercano y aplica a lo sumo CHECKPOINT_INTERVAL deltas; volver a
+// un punto de control solo reescribe los bloques y celdas que cambiaron entre
+// él y el turno actual, sin recorrer el tablero.
+class TurnHistory {
+public:
+    static const int CHECKPOINT_INTERVAL = 32;
+
+    // Historia nueva con el estado actual como turno 0; desde acá se
+    // registran los cambios de 'grid'
+    void reset(CellGrid& grid, const TurnState& state);
+
+    // Cierra un turno con lo que cambió desde el anterior. Si se había
+    // deshecho algo, los turnos rehechos pendientes se descartan
+    void commit(const CellGrid& grid, const TurnState& state);
+
+    bool undo(CellGrid& grid, TurnState& state) { return jumpTo(current - 1, grid, state); }
+    bool redo(CellGrid& grid, TurnState& state) { return jumpTo(current + 1, grid, state); }
+
+    // Deja grid y state como al final del turno indicado (0 = inicio)
+    bool jumpTo(int turn, CellGrid& grid, TurnState& state);
+
+    // Lo que reescribió el último jumpTo(), incluidos los cambios sin cerrar
+    // que deshizo, como en el diario de la grilla: una entrada por cambio con
+    // el valor de antes (una celda puede repetirse). Con esto los índices que
+    // siguen a la grilla se ponen al día sin recorrer el tablero
+    const std::vector<CellChange>& lastRestored() const { return restored; }
+
+    int turn() const { return current; }
+    int lastTurn() const { return (int)states.size() - 1; }
+
+    // Bytes de los deltas y de los bloques propios de cada punto de control
+    size_t memoryBytes() const;
+
+private:
+    static const int CHUNK_WORDS = 64;   // 4096 celdas por bloque de marcas
+    using Chunk = std::array<uint64_t, CHUNK_WORDS>;
+
+    struct Change {
+        int32_t cell;
+        uint8_t plane;   // como en CellChange
+        uint8_t before, after;
+    };
+
+    struct Checkpoint {
+        int turn = 0;
+        GridSnapshot types;
+        std::vector<std::shared_ptr<const Chunk>> flags[2];   // Traversed, Reflected
+        // Lo que puede diferir del punto anterior: celdas con tipo cambiado y
+        // bloques de marcas tocados (vacíos en el primero)
+        std::vector<int32_t> typeCells;
+        std::vector<int32_t> chunks;
+    };
+
+    void addCheckpoint(const CellGrid& grid);
+    int checkpointBefore(int turn) const;
+    long restoreCost(int k) const;
+    void restore(int k, CellGrid& grid);
+    void write(CellGrid& grid, int cell, int plane, uint8_t value);
+    void revertPending(CellGrid& grid);
+    long changeCount(int from, int to) const;
+
+    CellGrid* target = nullptr;
+    int current = 0;
+    std::vector<CellChange> journal;
+    std::vector<CellChange> restored;
+    std::vector<Change> changes;      // todos los deltas seguidos
+    std::vector<uint32_t> ends;       // ends[t]: fin de los cambios del turno t en 'changes'
+    std::vector<TurnState> states;    // states[t]: estado al final del turno t
+    std::vector<Checkpoint> checkpoints;
+    std::vector<char> dirtyChunk;     // para restore(), siempre en cero entre llamadas
+    std::vector<int32_t> restoreChunks, restoreCells;
+};
@@ -0,0 +1,109 @@
+#include "AStar.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+void BucketQueue::clear() {
+    for (int b = 0; b <= top; ++b) {
+        buckets[b].clear();
+    }
+    current = 0;
+    top = -1;
+    count = 0;
+}
+
+void BucketQueue::push(int priority, int32_t cell) {
+    if (priority >= (int)buckets.size()) {
+        buckets.resize(priority + 1);
+    }
+    buckets[priority].push_back(cell);
+    current = min(current, priority);
+    top = max(top, priority);
+    ++count;
+}
+
+int32_t BucketQueue::pop() {
+    while (buckets[current].empty()) ++current;
+    int32_t cell = buckets[current].back();
+    buckets[current].pop_back();
+    --count;
+    return cell;
+}
+
+void AStarSolver::resize(int w, int h) {
+    if (w == W && h == H) return;
+    W = w;
+    H = h;
+    seen.assign(W * H, 0);
+    closed.assign(W * H, 0);
+    g.assign(W * H, 0);
+    parent.assign(W * H, -1);
+    epoch = 0;
+    stats.allocations += 4;
+}
+
+bool AStarSolver::solve(const CellGrid& grid, int w, int h,
+                        int startX, int startY, int goalX, int goalY,
+                        vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    resize(w, h);
+    path.clear();
+    open.clear();
+
+    if (++epoch == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        fill(closed.begin(), closed.end(), 0);
+        epoch = 1;
+    }
+
+    auto heuristic = [&](int c) { return abs(c % W - goalX) + abs(c / W - goalY); };
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    seen[start] = epoch;
+    g[start] = 0;
+    parent[start] = -1;
+    open.push(heuristic(start), start);
+    stats.peakOpen = 1;
+
+    bool found = false;
+    while (!open.empty()) {
+        int u = open.pop();
+        // Duplicados: con heurística consistente la primera salida es la buena
+        if (closed[u] == epoch) continue;
+        closed[u] = epoch;
+        stats.expanded++;
+
+        if (u == goal) {
+            found = true;
+            break;
+        }
+
+        int step[4] = { W, -W, 1, -1 };
+        for (int mask = grid.passableMask(u); mask; mask &= mask - 1) {
+            int v = u + step[__builtin_ctz(mask)];
+            if (closed[v] == epoch) continue;
+            int cost = g[u] + 1;
+            if (seen[v] == epoch && g[v] <= cost) continue;
+            seen[v] = epoch;
+            g[v] = cost;
+            parent[v] = u;
+            open.push(cost + heuristic(v), v);
+        }
+        stats.peakOpen = max(stats.peakOpen, open.size());
+    }
+
+    if (found) {
+        for (int c = goal; c != -1; c = parent[c]) {
+            path.push_back({c / W, c % W});
+        }
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
@@ -0,0 +1,226 @@
+#include "BFS.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+void BFSWorkspace::resize(int w, int h) {
+    if (w == W && h == H) return;
+    W = w;
+    H = h;
+    stamp.assign(W * H, 0);
+    parent.assign(W * H, -1);
+    queue.assign(W * H, 0);
+    epoch = 0;
+    stats.allocations += 3;
+}
+
+bool BFSWorkspace::solve(const CellGrid& grid, int w, int h,
+                         int startX, int startY, int goalX, int goalY,
+                         vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    resize(w, h);
+    path.clear();
+
+    // Nueva época: todo lo marcado antes queda como no visitado
+    if (++epoch == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    stamp[start] = epoch;
+    parent[start] = -1;
+
+    bool found = false;
+    while (head < tail) {
+        int u = queue[head++];
+        if (u == goal) {
+            found = true;
+            break;
+        }
+
+        // Mismo orden de vecinos que antes: abajo, arriba, derecha, izquierda
+        int step[4] = { W, -W, 1, -1 };
+        for (int mask = grid.passableMask(u); mask; mask &= mask - 1) {
+            int v = u + step[__builtin_ctz(mask)];
+            if (stamp[v] == epoch) continue;
+            stamp[v] = epoch;
+            parent[v] = u;
+            queue[tail++] = v;
+        }
+    }
+    stats.expanded = head;
+
+    if (found) {
+        for (int c = goal; c != -1; c = parent[c]) {
+            path.push_back({c / W, c % W});
+        }
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
+
+void CompactBFS::resize(int n) {
+    if (n == cells) return;
+    cells = n;
+    stamp.assign(cells, 0);
+    parent.assign(cells, -1);
+    queue.assign(cells, 0);
+    epoch = 0;
+    stats.allocations += 3;
+}
+
+bool CompactBFS::solve(const CompactGrid& grid, int startX, int startY, int goalX, int goalY,
+                       vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    int PW = grid.paddedWidth();
+    resize(PW * (grid.height() + 2));
+    path.clear();
+
+    if (++epoch == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+
+    int start = grid.padded(startX, startY);
+    int goal = grid.padded(goalX, goalY);
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    stamp[start] = epoch;
+    parent[start] = -1;
+
+    bool found = false;
+    int step[4] = { PW, -PW, 1, -1 };
+    while (head < tail) {
+        int u = queue[head++];
+        if (u == goal) {
+            found = true;
+            break;
+        }
+        for (int d : step) {
+            int v = u + d;
+            if (grid.isWall(v) || stamp[v] == epoch) continue;
+            stamp[v] = epoch;
+            parent[v] = u;
+            queue[tail++] = v;
+        }
+    }
+    stats.expanded = head;
+
+    if (found) {
+        for (int c = goal; c != -1; c = parent[c]) {
+            path.push_back({c / PW - 1, c % PW});
+        }
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
+
+void BidirectionalBFS::resize(int w, int h) {
+    if (w == W && h == H) return;
+    W = w;
+    H = h;
+    for (auto& side : sides) {
+        side.stamp.assign(W * H, 0);
+        side.dist.assign(W * H, 0);
+        side.parent.assign(W * H, -1);
+        side.queue.assign(W * H, 0);
+    }
+    epoch = 0;
+    stats.allocations += 8;
+}
+
+bool BidirectionalBFS::solve(const CellGrid& grid, int w, int h,
+                             int startX, int startY, int goalX, int goalY,
+                             vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    resize(w, h);
+    path.clear();
+
+    if (++epoch == 0) {
+        for (auto& side : sides) fill(side.stamp.begin(), side.stamp.end(), 0);
+        epoch = 1;
+    }
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    int seeds[2] = {start, goal};
+    for (int k = 0; k < 2; ++k) {
+        Side& side = sides[k];
+        side.head = side.tail = 0;
+        side.queue[side.tail++] = seeds[k];
+        side.stamp[seeds[k]] = epoch;
+        side.dist[seeds[k]] = 0;
+        side.parent[seeds[k]] = -1;
+    }
+
+    // Hacia atrás el inicio, aunque sea muro, es alcanzable desde sus vecinos
+    auto towardStart = [&](int x, int y) {
+        if (!grid.isWall(start)) return 0;
+        int dx = startX - x, dy = startY - y;
+        return (dx == 0 && dy == 1) | (dx == 0 && dy == -1) << 1 | (dy == 0 && dx == 1) << 2 | (dy == 0 && dx == -1) << 3;
+    };
+    int step[4] = { W, -W, 1, -1 };
+
+    int meet = start == goal ? start : -1;
+    int best = start == goal ? 0 : INT32_MAX;
+
+    while (meet == -1) {
+        // Frente más chico primero
+        int k = (sides[0].tail - sides[0].head) <= (sides[1].tail - sides[1].head) ? 0 : 1;
+        Side& side = sides[k];
+        Side& other = sides[k ^ 1];
+        if (side.head == side.tail) break;
+
+        int levelEnd = side.tail;
+        while (side.head < levelEnd) {
+            int u = side.queue[side.head++];
+            // Hacia atrás se recorren aristas que entran en u: un muro no tiene
+            if (k == 1 && grid.isWall(u)) continue;
+
+            int y = u / W, x = u % W;
+            int mask = grid.passableMask(u) | (k == 1 ? towardStart(x, y) : 0);
+            for (; mask; mask &= mask - 1) {
+                int v = u + step[__builtin_ctz(mask)];
+                if (side.stamp[v] == epoch) continue;
+
+                side.stamp[v] = epoch;
+                side.dist[v] = side.dist[u] + 1;
+                side.parent[v] = u;
+                side.queue[side.tail++] = v;
+
+                if (other.stamp[v] == epoch && side.dist[v] + other.dist[v] < best) {
+                    best = side.dist[v] + other.dist[v];
+                    meet = v;
+                }
+            }
+        }
+    }
+    stats.expanded = sides[0].head + sides[1].head;
+
+    if (meet != -1) {
+        for (int c = meet; c != -1; c = sides[0].parent[c]) {
+            path.push_back({c / W, c % W});
+        }
+        reverse(path.begin(), path.end());
+        for (int c = sides[1].parent[meet]; c != -1; c = sides[1].parent[c]) {
+            path.push_back({c / W, c % W});
+        }
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return meet != -1;
+}
@@ -0,0 +1,296 @@
+#include "BitParallelBFS.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define ETG_AVX2_KERNEL 1
+#endif
+
+using namespace std;
+
+namespace {
+
+    // out = vecinos(f) & open & ~(f | prev), palabras [from, to).
+    // f tiene una palabra de relleno a cada lado para los acarreos horizontales.
+    void expandRowScalar(const uint64_t* up, const uint64_t* f, const uint64_t* down,
+                         const uint64_t* open, const uint64_t* prev, uint64_t* out,
+                         int from, int to) {
+        for (int w = from; w < to; ++w) {
+            uint64_t n = (f[w] << 1) | (f[w-1] >> 63) | (f[w] >> 1) | (f[w+1] << 63) | up[w] | down[w];
+            out[w] = n & open[w] & ~(f[w] | prev[w]);
+        }
+    }
+
+#ifdef ETG_AVX2_KERNEL
+    __attribute__((target("avx2")))
+    void expandRowAvx2(const uint64_t* up, const uint64_t* f, const uint64_t* down,
+                       const uint64_t* open, const uint64_t* prev, uint64_t* out,
+                       int from, int to) {
+        int w = from;
+        for (; w + 4 <= to; w += 4) {
+            __m256i c = _mm256_loadu_si256((const __m256i*)(f + w));
+            __m256i l = _mm256_loadu_si256((const __m256i*)(f + w - 1));
+            __m256i r = _mm256_loadu_si256((const __m256i*)(f + w + 1));
+            __m256i n = _mm256_or_si256(
+                _mm256_or_si256(_mm256_slli_epi64(c, 1), _mm256_srli_epi64(l, 63)),
+                _mm256_or_si256(_mm256_srli_epi64(c, 1), _mm256_slli_epi64(r, 63)));
+            n = _mm256_or_si256(n, _mm256_or_si256(
+                _mm256_loadu_si256((const __m256i*)(up + w)),
+                _mm256_loadu_si256((const __m256i*)(down + w))));
+            __m256i seen = _mm256_or_si256(c, _mm256_loadu_si256((const __m256i*)(prev + w)));
+            n = _mm256_andnot_si256(seen, _mm256_and_si256(n, _mm256_loadu_si256((const __m256i*)(open + w))));
+            _mm256_storeu_si256((__m256i*)(out + w), n);
+        }
+        expandRowScalar(up, f, down, open, prev, out, w, to);
+    }
+
+    const bool hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    void expandRow(const uint64_t* up, const uint64_t* f, const uint64_t* down,
+                   const uint64_t* open, const uint64_t* prev, uint64_t* out,
+                   int from, int to) {
+#ifdef ETG_AVX2_KERNEL
+        if (hasAvx2) {
+            expandRowAvx2(up, f, down, open, prev, out, from, to);
+            return;
+        }
+#endif
+        expandRowScalar(up, f, down, open, prev, out, from, to);
+    }
+}
+
+// Planos y frentes para un tablero de W x H
+void BitParallelBFS::build() {
+    words = (W + 63) / 64;
+    stride = words + 2;
+    open.assign(H * stride, 0);
+    for (auto& layer : ring) {
+        layer.bits.assign((H + 2) * stride, 0);
+        layer.lo.assign(H, 0);
+        layer.hi.assign(H, -1);
+        layer.rowMin = 0;
+        layer.rowMax = -1;
+    }
+}
+
+void BitParallelBFS::clearRow(Layer& layer, int r) {
+    if (layer.lo[r] <= layer.hi[r]) {
+        memset(row(layer, r) + layer.lo[r], 0, (layer.hi[r] - layer.lo[r] + 1) * sizeof(uint64_t));
+        layer.lo[r] = 0;
+        layer.hi[r] = -1;
+    }
+}
+
+void BitParallelBFS::clear(Layer& layer) {
+    for (int r = layer.rowMin; r <= layer.rowMax; ++r) {
+        clearRow(layer, r);
+    }
+    layer.rowMin = 0;
+    layer.rowMax = -1;
+}
+
+void BitParallelBFS::seed(int cell) {
+    for (auto& layer : ring) clear(layer);
+
+    int y = cell / W, x = cell % W;
+    cur = 0;
+    row(ring[cur], y)[x >> 6] |= uint64_t(1) << (x & 63);
+    ring[cur].lo[y] = ring[cur].hi[y] = x >> 6;
+    ring[cur].rowMin = ring[cur].rowMax = y;
+}
+
+// Avanza una capa. Devuelve false si el frente quedó vacío.
+bool BitParallelBFS::step() {
+    Layer& f = ring[cur];
+    Layer& next = ring[cur ^ 1];   // contiene la capa d-1 hasta que se sobrescribe
+
+    // Rango de palabras a calcular por fila, a partir de las filas vecinas del frente
+    int from = max(0, f.rowMin - 1);
+    int to = min(H - 1, f.rowMax + 1);
+    spans.resize(max(0, to - from + 1));
+    for (int r = from; r <= to; ++r) {
+        int lo = words, hi = -1;
+        for (int k = max(0, r - 1); k <= min(H - 1, r + 1); ++k) {
+            if (f.lo[k] <= f.hi[k]) {
+                lo = min(lo, f.lo[k]);
+                hi = max(hi, f.hi[k]);
+            }
+        }
+        // La palabra anterior y la siguiente reciben los acarreos horizontales
+        spans[r - from] = {max(0, lo - 1), min(words - 1, hi + 1)};
+    }
+
+    // Filas de d-1 fuera del rango calculado ya no aportan nada
+    for (int r = next.rowMin; r <= next.rowMax; ++r) {
+        if (r < from || r > to) clearRow(next, r);
+    }
+
+    int newMin = H, newMax = -1;
+    for (int r = from; r <= to; ++r) {
+        auto [a, b] = spans[r - from];
+        if (a > b) {
+            clearRow(next, r);
+            continue;
+        }
+
+        uint64_t* out = row(next, r);
+        if (next.lo[r] <= next.hi[r]) {
+            for (int w = next.lo[r]; w < min(a, next.hi[r] + 1); ++w) out[w] = 0;
+            for (int w = max(b + 1, next.lo[r]); w <= next.hi[r]; ++w) out[w] = 0;
+        }
+        // out y prev son la misma fila: cada palabra se lee antes de escribirse
+        expandRow(row(f, r - 1), row(f, r), row(f, r + 1),
+                  open.data() + r * stride + 1, out, out, a, b + 1);
+
+        int lo = a, hi = b;
+        while (lo <= hi && out[lo] == 0) ++lo;
+        while (hi >= lo && out[hi] == 0) --hi;
+        next.lo[r] = lo <= hi ? lo : 0;
+        next.hi[r] = lo <= hi ? hi : -1;
+        if (lo <= hi) {
+            newMin = min(newMin, r);
+            newMax = r;
+            if (counting) {
+                for (int w = lo; w <= hi; ++w) stats.expanded += __builtin_popcountll(out[w]);
+            }
+        }
+    }
+
+    cur ^= 1;
+    next.rowMin = newMin;
+    next.rowMax = newMax;
+    return newMax >= 0;
+}
+
+void BitParallelBFS::save(const Layer& layer, Band& band) const {
+    band.rowMin = layer.rowMin;
+    band.rowMax = layer.rowMax;
+    band.lo.clear();
+    band.hi.clear();
+    band.offset.clear();
+    band.words.clear();
+    for (int r = layer.rowMin; r <= layer.rowMax; ++r) {
+        band.lo.push_back(layer.lo[r]);
+        band.hi.push_back(layer.hi[r]);
+        band.offset.push_back(band.words.size());
+        const uint64_t* src = layer.bits.data() + (r + 1) * stride + 1;
+        for (int w = layer.lo[r]; w <= layer.hi[r]; ++w) band.words.push_back(src[w]);
+    }
+}
+
+void BitParallelBFS::load(const Band& band, Layer& layer) {
+    clear(layer);
+    layer.rowMin = band.rowMin;
+    layer.rowMax = band.rowMax;
+    for (int r = band.rowMin; r <= band.rowMax; ++r) {
+        int k = r - band.rowMin;
+        layer.lo[r] = band.lo[k];
+        layer.hi[r] = band.hi[k];
+        copy(band.words.begin() + band.offset[k],
+             band.words.begin() + band.offset[k] + max(0, band.hi[k] - band.lo[k] + 1),
+             row(layer, r) + band.lo[k]);
+    }
+}
+
+bool BitParallelBFS::contains(const Band& band, int cell) const {
+    int y = cell / W, w = (cell % W) >> 6;
+    if (y < band.rowMin || y > band.rowMax) return false;
+    int k = y - band.rowMin;
+    if (w < band.lo[k] || w > band.hi[k]) return false;
+    return (band.words[band.offset[k] + w - band.lo[k]] >> (cell % W & 63)) & 1;
+}
+
+bool BitParallelBFS::solve(const CellGrid& grid, int w, int h,
+                           int startX, int startY, int goalX, int goalY,
+                           vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    path.clear();
+
+    if (w != W || h != H) {
+        W = w;
+        H = h;
+        build();
+        stats.allocations += 7;
+    }
+    // Las filas del tablero de transitabilidad ya están en este formato
+    for (int y = 0; y < H; ++y) {
+        copy(grid.openRow(y), grid.openRow(y) + words, open.data() + y * stride + 1);
+    }
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+
+    // Ida: distancia y puntos de control. Cuando hay demasiados se descarta
+    // uno de cada dos y se duplica el intervalo, así quedan ~sqrt(D) de ~sqrt(D) capas
+    vector<Checkpoint> checkpoints;
+    int interval = 1;
+    int distance = 0;
+    bool found = start == goal;
+    counting = true;
+    seed(start);
+    while (!found) {
+        if (distance % interval == 0) {
+            checkpoints.push_back({distance, Band(), Band()});
+            save(ring[cur ^ 1], checkpoints.back().prev);
+            save(ring[cur], checkpoints.back().cur);
+            if ((int)checkpoints.size() > 2 * interval) {
+                interval *= 2;
+                size_t kept = 0;
+                for (size_t k = 0; k < checkpoints.size(); ++k) {
+                    if (checkpoints[k].layer % interval != 0) continue;
+                    if (k != kept) checkpoints[kept] = move(checkpoints[k]);
+                    ++kept;
+                }
+                checkpoints.resize(kept);
+            }
+        }
+        if (!step()) break;
+        ++distance;
+        found = (row(ring[cur], goalY)[goalX >> 6] >> (goalX & 63)) & 1;
+    }
+    counting = false;
+
+    if (found) {
+        // Vuelta: cada tramo se regenera desde su punto de control y se recorre
+        // buscando en la capa d-1 un vecino de la celda actual
+        vector<Band> layers;
+        int cell = goal;
+        path.push_back({goalY, goalX});
+        for (int c = (int)checkpoints.size() - 1; c >= 0; --c) {
+            int base = checkpoints[c].layer;
+            int top = (c + 1 < (int)checkpoints.size() ? checkpoints[c + 1].layer : distance) - 1;
+            load(checkpoints[c].prev, ring[0]);
+            load(checkpoints[c].cur, ring[1]);
+            cur = 1;
+            layers.resize(top - base + 1);
+            layers[0] = checkpoints[c].cur;
+            for (int d = base + 1; d <= top; ++d) {
+                step();
+                save(ring[cur], layers[d - base]);
+            }
+
+            for (int d = top; d >= base; --d) {
+                int y = cell / W, x = cell % W;
+                int next[4] = { y + 1 < H ? cell + W : -1, y > 0 ? cell - W : -1,
+                                x + 1 < W ? cell + 1 : -1, x > 0 ? cell - 1 : -1 };
+                for (int v : next) {
+                    if (v >= 0 && contains(layers[d - base], v)) {
+                        cell = v;
+                        break;
+                    }
+                }
+                path.push_back({cell / W, cell % W});
+            }
+        }
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
@@ -0,0 +1,32 @@
+#include "CompactGrid.hpp"
+
+using namespace std;
+
+namespace {
+    const uint64_t ALL_WALLS = 0x5555555555555555ull;
+
+    CompactCell compact(CellType t) {
+        switch (t) {
+            case CellType::Wall: return CompactCell::Wall;
+            case CellType::Crystal: return CompactCell::Crystal;
+            case CellType::Goal: return CompactCell::Goal;
+            default: return CompactCell::Open;
+        }
+    }
+}
+
+CompactGrid::CompactGrid(const CellGrid& grid) : W(grid.width()), H(grid.height()) {
+    stride = W / RUN + 1;
+    words.assign((long)(H + 2) * stride, ALL_WALLS);
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            set(x, y, compact(grid.type(y*W + x)));
+        }
+    }
+}
+
+void CompactGrid::set(int x, int y, CompactCell t) {
+    int c = padded(x, y);
+    int shift = (c & 31) << 1;
+    words[c >> 5] = (words[c >> 5] & ~(3ull << shift)) | uint64_t(t) << shift;
+}
@@ -0,0 +1,157 @@
+#include "CrystalReflector.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+void CrystalReflector::cellChanged(int x, int y) {
+    if (built) {
+        pending.push_back(y*W + x);
+    }
+}
+
+void CrystalReflector::build(CellGrid& grid) {
+    W = grid.width();
+    H = grid.height();
+    rowCrystals.assign(H, {});
+    colCrystals.assign(W, {});
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (grid.type(y*W + x) == CellType::Crystal) {
+                rowCrystals[y].push_back(x);
+                colCrystals[x].push_back(y);
+            }
+        }
+    }
+    // Recalculo completo; desde acá solo cambios incrementales
+    kernel.run(grid, rowCrystals, mirrored);
+    pending.clear();
+    built = true;
+}
+
+// Reflejos de una celda recorrida en los cristales a su derecha y debajo
+void CrystalReflector::visit(CellGrid& grid, int cell) {
+    int y = cell / W, x = cell % W;
+    const auto& row = rowCrystals[y];
+    for (auto it = upper_bound(row.begin(), row.end(), x); it != row.end(); ++it) {
+        work++;
+        int xt = 2 * *it - x;
+        if (xt >= W) break;
+        mirror(grid, y*W + xt);
+    }
+    const auto& col = colCrystals[x];
+    for (auto it = upper_bound(col.begin(), col.end(), y); it != col.end(); ++it) {
+        work++;
+        int yt = 2 * *it - y;
+        if (yt >= H) break;
+        mirror(grid, yt*W + x);
+    }
+}
+
+void CrystalReflector::mirror(CellGrid& grid, int cell) {
+    uint64_t bit = 1ull << (cell & 63);
+    if (mirrored[cell >> 6] & bit) return;
+    mirrored[cell >> 6] |= bit;
+    if (grid.isWall(cell)) return;
+    grid.set(CellFlag::Reflected, cell);
+    if (!grid.has(CellFlag::Traversed, cell)) {
+        grid.set(CellFlag::Traversed, cell);
+        stack.push_back(cell);
+    }
+}
+
+void CrystalReflector::drain(CellGrid& grid) {
+    while (!stack.empty()) {
+        int cell = stack.back();
+        stack.pop_back();
+        visit(grid, cell);
+    }
+}
+
+void CrystalReflector::traverse(CellGrid& grid, int x, int y) {
+    work = 0;
+    if (!built || grid.width() != W || grid.height() != H) {
+        build(grid);
+    }
+
+    // Muros que cambiaron desde el último paso: un reflejo ya espejado se
+    // apaga si ahora es muro y se enciende (y propaga) si dejó de serlo
+    for (int cell : pending) {
+        if (!((mirrored[cell >> 6] >> (cell & 63)) & 1)) continue;
+        if (grid.isWall(cell)) {
+            grid.reset(CellFlag::Reflected, cell);
+        } else {
+            grid.set(CellFlag::Reflected, cell);
+            if (!grid.has(CellFlag::Traversed, cell)) {
+                grid.set(CellFlag::Traversed, cell);
+                stack.push_back(cell);
+            }
+        }
+    }
+    pending.clear();
+
+    int cell = y*W + x;
+    if (!grid.has(CellFlag::Traversed, cell)) {
+        grid.set(CellFlag::Traversed, cell);
+        stack.push_back(cell);
+    }
+    drain(grid);
+}
+
+// Alguna celda recorrida que un cristal refleja en 'cell': a la izquierda en
+// su fila o arriba en su columna, a la misma distancia del cristal
+bool CrystalReflector::hasSource(const CellGrid& grid, int cell) const {
+    int y = cell / W, x = cell % W;
+    const auto& row = rowCrystals[y];
+    for (auto it = lower_bound(row.begin(), row.end(), (x + 1) / 2); it != row.end() && *it < x; ++it) {
+        if (grid.has(CellFlag::Traversed, y*W + 2 * *it - x)) return true;
+    }
+    const auto& col = colCrystals[x];
+    for (auto it = lower_bound(col.begin(), col.end(), (y + 1) / 2); it != col.end() && *it < y; ++it) {
+        if (grid.has(CellFlag::Traversed, (2 * *it - y)*W + x)) return true;
+    }
+    return false;
+}
+
+// Los mismos reflejos que visit(), pero cada uno queda espejado solo si
+// todavía tiene algún origen recorrido
+void CrystalReflector::recheckTargets(const CellGrid& grid, int cell) {
+    int y = cell / W, x = cell % W;
+    auto recheck = [&](int target) {
+        uint64_t bit = 1ull << (target & 63);
+        if (hasSource(grid, target)) mirrored[target >> 6] |= bit;
+        else mirrored[target >> 6] &= ~bit;
+    };
+    const auto& row = rowCrystals[y];
+    for (auto it = upper_bound(row.begin(), row.end(), x); it != row.end(); ++it) {
+        work++;
+        int xt = 2 * *it - x;
+        if (xt >= W) break;
+        recheck(y*W + xt);
+    }
+    const auto& col = colCrystals[x];
+    for (auto it = upper_bound(col.begin(), col.end(), y); it != col.end(); ++it) {
+        work++;
+        int yt = 2 * *it - y;
+        if (yt >= H) break;
+        recheck(yt*W + x);
+    }
+}
+
+void CrystalReflector::turnRestored(const CellGrid& grid, const vector<CellChange>& changes) {
+    work = 0;
+    if (!built) return;
+    // Lo pendiente era del turno que se deja; el del turno al que se vuelve
+    // (su evento) lo pasa quien llama con cellChanged()
+    pending.clear();
+    for (const CellChange& c : changes) {
+        // Un cristal que aparece o desaparece cambia los índices: se rehace todo
+        if (c.plane == 0 && (CellType(c.before) == CellType::Crystal || grid.type(c.cell) == CellType::Crystal)) {
+            reset();
+            return;
+        }
+    }
+    for (const CellChange& c : changes) {
+        if (c.plane == 1 + int(CellFlag::Traversed)) recheckTargets(grid, c.cell);
+    }
+}
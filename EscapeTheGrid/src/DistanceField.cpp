@@ -0,0 +1,54 @@
+#include "DistanceField.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+bool DistanceField::update(const CellGrid& grid, int w, int h, int goalX, int goalY) {
+    if (!dirty && w == W && h == H && goal == goalY*w + goalX) return false;
+
+    W = w;
+    H = h;
+    goal = goalY*W + goalX;
+    dist.assign(W * H, UNREACHABLE);
+    queue.resize(W * H);
+
+    // BFS inverso: u es predecesor de v si se puede entrar en v. A un muro se le
+    // asigna distancia (el jugador puede haber quedado encima) pero no se expande.
+    int head = 0, tail = 0;
+    queue[tail++] = goal;
+    dist[goal] = 0;
+    while (head < tail) {
+        int v = queue[head++];
+        int y = v / W, x = v % W;
+        int next[4] = { y + 1 < H ? v + W : -1, y > 0 ? v - W : -1,
+                        x + 1 < W ? v + 1 : -1, x > 0 ? v - 1 : -1 };
+        for (int u : next) {
+            if (u < 0 || dist[u] != UNREACHABLE) continue;
+            dist[u] = dist[v] + 1;
+            if (!grid.isWall(u)) {
+                queue[tail++] = u;
+            }
+        }
+    }
+
+    dirty = false;
+    return true;
+}
+
+bool DistanceField::nextStep(const CellGrid& grid, int x, int y, int& nextX, int& nextY) const {
+    int c = y*W + x;
+    if (c == goal || dist[c] == UNREACHABLE) return false;
+
+    int best = -1;
+    int step[4] = { W, -W, 1, -1 };
+    for (int mask = grid.passableMask(c); mask; mask &= mask - 1) {
+        int v = c + step[__builtin_ctz(mask)];
+        if (best == -1 || dist[v] < dist[best]) best = v;
+    }
+    if (best == -1 || dist[best] >= dist[c]) return false;
+
+    nextX = best % W;
+    nextY = best / W;
+    return true;
+}
@@ -0,0 +1,44 @@
+#include "FreeCellSet.hpp"
+
+using namespace std;
+
+void FreeCellSet::rebuild(const CellGrid& grid) {
+    int n = grid.size();
+    cells.clear();
+    cells.reserve(n);
+    slot.assign(n, -1);
+    for (int i = 0; i < n; ++i) {
+        if (grid.type(i) == CellType::Empty) {
+            slot[i] = cells.size();
+            cells.push_back(i);
+        }
+    }
+}
+
+void FreeCellSet::insert(int cell) {
+    if (slot[cell] >= 0) return;
+    slot[cell] = cells.size();
+    cells.push_back(cell);
+}
+
+void FreeCellSet::erase(int cell) {
+    int k = slot[cell];
+    if (k < 0) return;
+    int last = cells.back();
+    cells[k] = last;
+    slot[last] = k;
+    cells.pop_back();
+    slot[cell] = -1;
+}
+
+int FreeCellSet::pick(int excluded) {
+    int n = cells.size();
+    int k = excluded >= 0 ? slot[excluded] : -1;
+    if (k < 0) {
+        return n > 0 ? cells[uniform_int_distribution<int>(0, n - 1)(rng)] : -1;
+    }
+    // La excluida cuenta como si estuviera al final: se elige entre las otras n-1
+    if (n <= 1) return -1;
+    int r = uniform_int_distribution<int>(0, n - 2)(rng);
+    return cells[r == k ? n - 1 : r];
+}
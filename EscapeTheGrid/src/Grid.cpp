@@ -0,0 +1,79 @@
+#include "Grid.hpp"
+
+#include <cstring>
+
+using namespace std;
+
+void CellGrid::resize(int w, int h) {
+    W = w;
+    H = h;
+    types.assign(W * H, uint8_t(CellType::Empty));
+    openStride = W / 64 + 1;
+    open.assign((long)(H + 2) * openStride, 0);
+    for (int y = 0; y < H; ++y) {
+        uint64_t* row = open.data() + (long)(y + 1) * openStride;
+        for (int x = 0; x < W; x += 64) {
+            row[x >> 6] = W - x >= 64 ? ~0ull : (1ull << (W - x)) - 1;
+        }
+    }
+    neighbors.assign((W * H + 1) / 2, 0);
+    for (int i = 0; i < W * H; ++i) {
+        int x = i % W, y = i / W;
+        int mask = (y + 1 < H) | (y > 0) << 1 | (x + 1 < W) << 2 | (x > 0) << 3;
+        neighbors[i >> 1] |= mask << ((i & 1) << 2);
+    }
+    for (auto& plane : planes) {
+        plane.assign((W * H + 63) / 64, 0);
+    }
+    if (tracking) touchedBits.assign(planes[0].size(), 0);
+    touched.clear();
+    allTouched = true;
+}
+
+void CellGrid::setType(int i, CellType t) {
+    if (types[i] == uint8_t(t)) return;
+    if (journal) journal->push_back({i, 0, types[i]});
+    touch(i);
+    bool wasWall = isWall(i);
+    types[i] = uint8_t(t);
+    bool wall = t == CellType::Wall;
+    if (wall == wasWall) return;
+
+    int x = i % W, y = i / W;
+    long b = openIndex(x, y);
+    if (wall) open[b >> 6] &= ~(1ull << (b & 63));
+    else open[b >> 6] |= 1ull << (b & 63);
+
+    // Cada vecino tiene un bit que apunta a i: abajo de i apunta arriba, etc.
+    auto update = [&](int n, int bit) {
+        uint8_t m = uint8_t(1 << (bit + ((n & 1) << 2)));
+        if (wall) neighbors[n >> 1] &= ~m;
+        else neighbors[n >> 1] |= m;
+    };
+    if (y + 1 < H) update(i + W, 1);
+    if (y > 0) update(i - W, 0);
+    if (x + 1 < W) update(i + 1, 3);
+    if (x > 0) update(i - 1, 2);
+}
+
+void CellGrid::clear(CellFlag f) {
+    auto& plane = planes[int(f)];
+    if (!plane.empty()) memset(plane.data(), 0, plane.size() * sizeof(uint64_t));
+    allTouched = true;
+}
+
+void CellGrid::trackChanges(bool on) {
+    tracking = on;
+    touchedBits.assign(on ? planes[0].size() : 0, 0);
+    touched.clear();
+    allTouched = true;
+}
+
+bool CellGrid::takeChanges(vector<int>& cells) {
+    cells.swap(touched);
+    touched.clear();
+    for (int i : cells) touchedBits[i >> 6] &= ~(1ull << (i & 63));
+    bool all = allTouched;
+    allTouched = false;
+    return all;
+}
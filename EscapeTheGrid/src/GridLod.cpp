@@ -0,0 +1,135 @@
+#include "GridLod.hpp"
+
+#include <algorithm>
+
+#include "GridRenderer.hpp"
+
+using namespace std;
+
+void GridLod::build(const CellGrid& grid, float size) {
+    W = grid.width();
+    H = grid.height();
+    cellSize = size;
+    shift = 0;
+    while ((long)((W + (1 << shift) - 1) >> shift) * ((H + (1 << shift) - 1) >> shift) > BASE_TEXELS) ++shift;
+    BW = (W + (1 << shift) - 1) >> shift;
+    BH = (H + (1 << shift) - 1) >> shift;
+    pixels.assign((long)BW * BH * 4, 0);
+    marked.assign((long)BW * BH, 0);
+    dirty.clear();
+
+    tilesX = (BW + TILE - 1) / TILE;
+    tilesY = (BH + TILE - 1) / TILE;
+    tiles.clear();
+    tiles.resize(tilesX * tilesY);
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            Tile& tile = tiles[ty * tilesX + tx];
+            tile.x0 = tx * TILE;
+            tile.y0 = ty * TILE;
+            tile.w = min(TILE, BW - tile.x0);
+            tile.h = min(TILE, BH - tile.y0);
+            tile.texture.create(tile.w, tile.h);
+            tile.texture.setSmooth(true);
+        }
+    }
+    stale = true;
+}
+
+// Promedio de los colores del bloque (con su alfa) en el texel (tx,ty)
+void GridLod::paintTexel(const CellGrid& grid, int tx, int ty) {
+    int x0 = tx << shift, y0 = ty << shift;
+    int x1 = min(W, x0 + (1 << shift)), y1 = min(H, y0 + (1 << shift));
+    unsigned r = 0, g = 0, b = 0, a = 0;
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            int cell = y*W + x;
+            sf::Color c = GridRenderer::cellColor(grid.type(cell), x, y, grid.has(CellFlag::Visited, cell),
+                                                  grid.has(CellFlag::Traversed, cell),
+                                                  grid.has(CellFlag::Reflected, cell));
+            r += c.r;
+            g += c.g;
+            b += c.b;
+            a += c.a;
+        }
+    }
+    unsigned n = (x1 - x0) * (y1 - y0);
+    uint8_t* p = &pixels[((long)ty * BW + tx) * 4];
+    p[0] = uint8_t(r / n);
+    p[1] = uint8_t(g / n);
+    p[2] = uint8_t(b / n);
+    p[3] = uint8_t(a / n);
+}
+
+void GridLod::markTexel(int tx, int ty) {
+    Tile& tile = tiles[(ty / TILE) * tilesX + tx / TILE];
+    int x = tx - tile.x0, y = ty - tile.y0;
+    if (tile.dirtyX0 >= tile.dirtyX1) {
+        tile.dirtyX0 = x;
+        tile.dirtyY0 = y;
+        tile.dirtyX1 = x + 1;
+        tile.dirtyY1 = y + 1;
+    } else {
+        tile.dirtyX0 = min(tile.dirtyX0, x);
+        tile.dirtyY0 = min(tile.dirtyY0, y);
+        tile.dirtyX1 = max(tile.dirtyX1, x + 1);
+        tile.dirtyY1 = max(tile.dirtyY1, y + 1);
+    }
+}
+
+void GridLod::cellChanged(int cell) {
+    if (stale || !built()) return;
+    int texel = ((cell / W) >> shift) * BW + ((cell % W) >> shift);
+    if (marked[texel]) return;
+    marked[texel] = 1;
+    dirty.push_back(texel);
+}
+
+void GridLod::update(const CellGrid& grid) {
+    if (stale) {
+        for (int ty = 0; ty < BH; ++ty) {
+            for (int tx = 0; tx < BW; ++tx) paintTexel(grid, tx, ty);
+        }
+        for (int texel : dirty) marked[texel] = 0;
+        dirty.clear();
+        for (auto& tile : tiles) {
+            tile.dirtyX0 = tile.dirtyY0 = 0;
+            tile.dirtyX1 = tile.w;
+            tile.dirtyY1 = tile.h;
+        }
+        stale = false;
+    } else {
+        for (int texel : dirty) {
+            marked[texel] = 0;
+            paintTexel(grid, texel % BW, texel / BW);
+            markTexel(texel % BW, texel / BW);
+        }
+        dirty.clear();
+    }
+
+    // Solo el rectángulo tocado de cada bloque, y de nuevo sus mipmaps
+    for (auto& tile : tiles) {
+        if (tile.dirtyX0 >= tile.dirtyX1) continue;
+        int w = tile.dirtyX1 - tile.dirtyX0, h = tile.dirtyY1 - tile.dirtyY0;
+        scratch.resize((long)w * h * 4);
+        for (int y = 0; y < h; ++y) {
+            const uint8_t* row = &pixels[((long)(tile.y0 + tile.dirtyY0 + y) * BW + tile.x0 + tile.dirtyX0) * 4];
+            copy(row, row + w * 4, &scratch[(long)y * w * 4]);
+        }
+        tile.texture.update(scratch.data(), w, h, tile.dirtyX0, tile.dirtyY0);
+        tile.texture.generateMipmap();
+        tile.dirtyX0 = tile.dirtyX1 = 0;
+    }
+}
+
+void GridLod::draw(sf::RenderTarget& target, const sf::FloatRect& visible) const {
+    float texelSize = (1 << shift) * cellSize;
+    for (const auto& tile : tiles) {
+        sf::FloatRect area(tile.x0 * texelSize, tile.y0 * texelSize, tile.w * texelSize, tile.h * texelSize);
+        if (!area.intersects(visible)) continue;
+        sf::Sprite sprite(tile.texture);
+        sprite.setPosition(area.left, area.top);
+        sprite.setScale(texelSize, texelSize);
+        target.draw(sprite);
+    }
+}
@@ -0,0 +1,267 @@
+#include "GridRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+    const float OUTLINE_THICKNESS = 0.5f;
+    const sf::Color OUTLINE_COLOR(100, 100, 100, 100);
+    const sf::Color CRYSTAL_OVERLAY(255, 255, 255, 50);
+
+    sf::Vector2f normalOf(sf::Vector2f p1, sf::Vector2f p2) {
+        sf::Vector2f n(p1.y - p2.y, p2.x - p1.x);
+        float length = sqrt(n.x * n.x + n.y * n.y);
+        if (length != 0.f) n /= length;
+        return n;
+    }
+}
+
+sf::Color GridRenderer::cellColor(CellType type, int x, int y, bool visited, bool traversed, bool reflected) {
+    // IMPORTANTE: La meta (Goal) siempre debe ser verde, sin importar otros estados
+    if (type == CellType::Goal) return sf::Color(0, 200, 0, 150);
+
+    if (type == CellType::Crystal) return sf::Color(0, 255, 255, 180);
+    if (reflected) return sf::Color(150, 220, 255, 200);
+    if (traversed) return sf::Color(192, 192, 192, 200);
+    if (visited) return sf::Color(150, 150, 255, 150);
+
+    switch (type) {
+        case CellType::Wall: return sf::Color(40, 40, 40);
+        case CellType::Start: return sf::Color(100, 255, 100, 200);
+        case CellType::Empty:
+        default: return ((x + y) % 2 == 0) ? sf::Color(120, 120, 200, 120) : sf::Color(100, 100, 180, 120);
+    }
+}
+
+void GridRenderer::build(CellGrid& grid, float size) {
+    grid.trackChanges(true);
+    W = grid.width();
+    H = grid.height();
+    cellSize = size;
+    ww = wh = 0;
+    vertices.clear();
+    bufferReady = false;
+    lod.reset();
+    lodMode = false;
+    shader.reset();
+}
+
+bool GridRenderer::useShader(const CellGrid& grid, bool on) {
+    if (on && !shader.built() && !shader.build(grid, cellSize)) return false;
+    shaderMode = on;
+    return true;
+}
+
+void GridRenderer::buildWindow(const CellGrid& grid, int x0, int y0, int x1, int y1) {
+    wx = x0;
+    wy = y0;
+    ww = x1 - x0;
+    wh = y1 - y0;
+    outlines = ww * wh <= OUTLINE_LIMIT;
+    vertices.clear();
+    firstVertex.assign(ww * wh, 0);
+    crystal.assign(ww * wh, 0);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            int local = (y - y0) * ww + (x - x0);
+            crystal[local] = grid.type(y*W + x) == CellType::Crystal;
+            firstVertex[local] = (int)vertices.getVertexCount();
+            addCell(x, y, crystal[local]);
+        }
+    }
+    bufferReady = false;
+    repaint = true;
+}
+
+// Triángulo de la celda alternando hacia arriba y hacia abajo, estirado 10
+// a los lados para que encajen entre sí
+void GridRenderer::addCell(int x, int y, bool isCrystal) {
+    const float verticalGap = 8.f;
+    const float horizontalGap = 3.f;
+    const float horizontalStretch = 10.f;
+    bool up = (x + y) % 2 == 0;
+
+    float px = x * cellSize + horizontalGap/2;
+    float py = y * cellSize + verticalGap/2;
+    float triWidth = cellSize - horizontalGap;
+    float triHeight = cellSize - verticalGap;
+
+    float left = px - horizontalStretch/2;
+    float right = px + triWidth + horizontalStretch/2;
+    float centerX = px + triWidth / 2.f;
+    float top = py;
+    float bottom = py + triHeight;
+
+    sf::Vector2f points[3];
+    if (up) {
+        points[0] = {centerX, top};
+        points[1] = {left, bottom};
+        points[2] = {right, bottom};
+    } else {
+        points[0] = {centerX, bottom};
+        points[1] = {left, top};
+        points[2] = {right, top};
+    }
+    addShape(points, sf::Color::Transparent);
+    if (isCrystal) addShape(points, CRYSTAL_OVERLAY);
+}
+
+// Relleno y contorno como los arma sf::Shape: cada vértice se corre hacia
+// afuera por la bisectriz de sus dos lados y cada lado es un cuadrilátero
+void GridRenderer::addShape(const sf::Vector2f* p, sf::Color fill) {
+    for (int i = 0; i < 3; ++i) vertices.append(sf::Vertex(p[i], fill));
+    if (!outlines) return;
+
+    float minX = min(p[0].x, min(p[1].x, p[2].x)), maxX = max(p[0].x, max(p[1].x, p[2].x));
+    float minY = min(p[0].y, min(p[1].y, p[2].y)), maxY = max(p[0].y, max(p[1].y, p[2].y));
+    sf::Vector2f center((minX + maxX) / 2.f, (minY + maxY) / 2.f);
+
+    sf::Vector2f outer[3];
+    for (int i = 0; i < 3; ++i) {
+        sf::Vector2f p0 = p[(i + 2) % 3], p1 = p[i], p2 = p[(i + 1) % 3];
+        sf::Vector2f n1 = normalOf(p0, p1), n2 = normalOf(p1, p2);
+        sf::Vector2f toCenter = center - p1;
+        if (n1.x * toCenter.x + n1.y * toCenter.y > 0) n1 = -n1;
+        if (n2.x * toCenter.x + n2.y * toCenter.y > 0) n2 = -n2;
+        float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+        outer[i] = p1 + (n1 + n2) / factor * OUTLINE_THICKNESS;
+    }
+    for (int i = 0; i < 3; ++i) {
+        int j = (i + 1) % 3;
+        vertices.append(sf::Vertex(p[i], OUTLINE_COLOR));
+        vertices.append(sf::Vertex(outer[i], OUTLINE_COLOR));
+        vertices.append(sf::Vertex(p[j], OUTLINE_COLOR));
+        vertices.append(sf::Vertex(outer[i], OUTLINE_COLOR));
+        vertices.append(sf::Vertex(p[j], OUTLINE_COLOR));
+        vertices.append(sf::Vertex(outer[j], OUTLINE_COLOR));
+    }
+}
+
+// Colores de relleno de una celda de la ventana; false si cambió de cristal
+// a otra cosa o al revés, que cambia la geometría
+bool GridRenderer::paint(const CellGrid& grid, int x, int y) {
+    int cell = y*W + x, local = (y - wy) * ww + (x - wx);
+    CellType type = grid.type(cell);
+    if ((type == CellType::Crystal) != bool(crystal[local])) return false;
+    sf::Color c = cellColor(type, x, y, grid.has(CellFlag::Visited, cell),
+                            grid.has(CellFlag::Traversed, cell), grid.has(CellFlag::Reflected, cell));
+    sf::Vertex* v = &vertices[firstVertex[local]];
+    v[0].color = v[1].color = v[2].color = c;
+    return true;
+}
+
+void GridRenderer::upload(int first, int count) {
+    if (!bufferReady || count <= 0) return;
+    buffer.update(&vertices[first], count, first);
+    uploaded += count;
+}
+
+void GridRenderer::update(CellGrid& grid, const sf::RenderTarget& target) {
+    uploaded = 0;
+    if (grid.width() != W || grid.height() != H) {
+        build(grid, cellSize);
+    }
+    bool all = grid.takeChanges(dirty);
+    if (lod.built()) {
+        if (all) lod.invalidate();
+        else for (int cell : dirty) lod.cellChanged(cell);
+    }
+    if (shader.built()) {
+        if (all) shader.invalidate();
+        else for (int cell : dirty) shader.cellChanged(cell);
+    }
+
+    const sf::View& view = target.getView();
+    visible = sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
+    float cellPixels = target.getViewport(view).width / view.getSize().x * cellSize;
+    float visibleCells = (visible.width / cellSize) * (visible.height / cellSize);
+    if (shaderMode && !shader.built() && !shader.build(grid, cellSize)) {
+        shaderMode = false;
+    }
+    if (shaderMode) {
+        lodMode = false;
+        shader.update(grid, visibleCells <= OUTLINE_LIMIT);
+        repaint = true;
+        return;
+    }
+    if (lodAllowed) lodMode = cellPixels < 1.f || visibleCells > GEOMETRY_LIMIT;
+    else lodMode = visibleCells > MEASURE_GEOMETRY_LIMIT;
+    if (lodMode) {
+        if (!lod.built()) lod.build(grid, cellSize);
+        lod.update(grid);
+        // Lo que cambie mientras tanto no llega a la ventana de triángulos
+        repaint = true;
+        return;
+    }
+
+    // Celdas que tocan lo visible; los triángulos se salen un poco de su
+    // celda, por eso una más de cada lado
+    int x0 = max(0, int(floor(visible.left / cellSize)) - 1);
+    int y0 = max(0, int(floor(visible.top / cellSize)) - 1);
+    int x1 = min(W, int(ceil((visible.left + visible.width) / cellSize)) + 1);
+    int y1 = min(H, int(ceil((visible.top + visible.height) / cellSize)) + 1);
+    if (x0 >= x1 || y0 >= y1) {
+        x0 = y0 = x1 = y1 = 0;
+    }
+    if (x0 < wx || y0 < wy || x1 > wx + ww || y1 > wy + wh || ww * wh == 0) {
+        // Un cuarto de la vista de margen para no rearmar en cada paso al desplazarse
+        int mx = (x1 - x0) / 4 + 1, my = (y1 - y0) / 4 + 1;
+        buildWindow(grid, max(0, x0 - mx), max(0, y0 - my), min(W, x1 + mx), min(H, y1 + my));
+    }
+
+    if (!bufferReady && sf::VertexBuffer::isAvailable() && vertices.getVertexCount() > 0) {
+        bufferReady = buffer.create(vertices.getVertexCount());
+        repaint = true;
+    }
+
+    if (all || repaint) {
+        repaint = false;
+        for (int y = wy; y < wy + wh; ++y) {
+            for (int x = wx; x < wx + ww; ++x) {
+                if (!paint(grid, x, y)) {
+                    buildWindow(grid, wx, wy, wx + ww, wy + wh);
+                    update(grid, target);
+                    return;
+                }
+            }
+        }
+        upload(0, (int)vertices.getVertexCount());
+        return;
+    }
+
+    // Celdas en orden para juntar rangos vecinos en una sola subida
+    sort(dirty.begin(), dirty.end());
+    int from = -1, to = -1;
+    for (int cell : dirty) {
+        int x = cell % W, y = cell / W;
+        if (x < wx || x >= wx + ww || y < wy || y >= wy + wh) continue;
+        if (!paint(grid, x, y)) {
+            buildWindow(grid, wx, wy, wx + ww, wy + wh);
+            update(grid, target);
+            return;
+        }
+        int first = firstVertex[(y - wy) * ww + (x - wx)];
+        if (from < 0 || first > to + MERGE_GAP) {
+            if (from >= 0) upload(from, to - from);
+            from = first;
+        }
+        to = first + 3;
+    }
+    upload(from, to - from);
+}
+
+void GridRenderer::draw(sf::RenderTarget& target) const {
+    if (shaderMode) {
+        shader.draw(target, visible);
+        return;
+    }
+    if (lodMode) {
+        lod.draw(target, visible);
+        return;
+    }
+    if (ww * wh == 0) return;
+    if (bufferReady) target.draw(buffer);
+    else target.draw(vertices);
+}
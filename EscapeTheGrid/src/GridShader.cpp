@@ -0,0 +1,191 @@
+#include "GridShader.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    const char* VERTEX_SHADER = R"(
+varying vec2 world;
+
+void main() {
+    world = gl_Vertex.xy;
+    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
+}
+)";
+
+    // Misma geometría que GridRenderer::addCell y mismos colores que
+    // GridRenderer::cellColor. Un triángulo se sale hasta unos 5 px de su
+    // celda hacia los lados, así que se prueban la celda y sus dos vecinas de
+    // fila, en el orden en que se dibujan, mezclando como BlendAlpha.
+    const char* FRAGMENT_SHADER = R"(
+uniform sampler2D state;
+uniform vec2 size;
+uniform float cellSize;
+uniform float outlines;
+varying vec2 world;
+
+const vec4 OUTLINE = vec4(100.0, 100.0, 100.0, 100.0) / 255.0;
+const vec4 CRYSTAL_OVERLAY = vec4(255.0, 255.0, 255.0, 50.0) / 255.0;
+
+vec4 over(vec4 dst, vec4 src) {
+    return vec4(src.rgb * src.a + dst.rgb * (1.0 - src.a), src.a + dst.a * (1.0 - src.a));
+}
+
+vec4 fillColor(vec4 s, float type, float x, float y) {
+    if (type == 3.0) return vec4(0.0, 200.0, 0.0, 150.0) / 255.0;
+    if (type == 4.0) return vec4(0.0, 255.0, 255.0, 180.0) / 255.0;
+    if (s.a > 0.5) return vec4(150.0, 220.0, 255.0, 200.0) / 255.0;
+    if (s.b > 0.5) return vec4(192.0, 192.0, 192.0, 200.0) / 255.0;
+    if (s.g > 0.5) return vec4(150.0, 150.0, 255.0, 150.0) / 255.0;
+    if (type == 1.0) return vec4(40.0, 40.0, 40.0, 255.0) / 255.0;
+    if (type == 2.0) return vec4(100.0, 255.0, 100.0, 200.0) / 255.0;
+    if (mod(x + y, 2.0) == 0.0) return vec4(120.0, 120.0, 200.0, 120.0) / 255.0;
+    return vec4(100.0, 100.0, 180.0, 120.0) / 255.0;
+}
+
+// Distancia con signo al lado a-b, positiva hacia 'inside'
+float edge(vec2 a, vec2 b, vec2 inside, vec2 p) {
+    vec2 n = normalize(vec2(a.y - b.y, b.x - a.x));
+    if (dot(n, inside - a) < 0.0) n = -n;
+    return dot(n, p - a);
+}
+
+// Positiva adentro del triángulo de la celda; entre -0.5 y 0 es el contorno
+float shape(float x, float y, vec2 p) {
+    float px = x * cellSize + 1.5;
+    float py = y * cellSize + 4.0;
+    float left = px - 5.0;
+    float right = px + cellSize - 3.0 + 5.0;
+    float centerX = px + (cellSize - 3.0) / 2.0;
+    float top = py;
+    float bottom = py + cellSize - 8.0;
+    vec2 a, b, c;
+    if (mod(x + y, 2.0) == 0.0) {
+        a = vec2(centerX, top);
+        b = vec2(left, bottom);
+        c = vec2(right, bottom);
+    } else {
+        a = vec2(centerX, bottom);
+        b = vec2(left, top);
+        c = vec2(right, top);
+    }
+    return min(edge(a, b, c, p), min(edge(b, c, a, p), edge(c, a, b, p)));
+}
+
+void main() {
+    // Como el rasterizador: un centro de píxel justo sobre un borde horizontal
+    // queda del lado de arriba
+    vec2 p = world - vec2(0.0, 1.0 / 1024.0);
+    vec4 color = vec4(0.0);
+    float y = floor(p.y / cellSize);
+    if (y >= 0.0 && y < size.y) {
+        float cx = floor(p.x / cellSize);
+        for (int i = -1; i <= 1; ++i) {
+            float x = cx + float(i);
+            if (x < 0.0 || x >= size.x) continue;
+            float d = shape(x, y, p);
+            if (d < -0.5 || (d < 0.0 && outlines < 0.5)) continue;
+            vec4 s = texture2D(state, (vec2(x, y) + 0.5) / size);
+            float type = floor(s.r * 255.0 + 0.5);
+            color = over(color, d >= 0.0 ? fillColor(s, type, x, y) : OUTLINE);
+            if (type == 4.0) color = over(color, d >= 0.0 ? CRYSTAL_OVERLAY : OUTLINE);
+        }
+    }
+    if (color.a <= 0.0) discard;
+    gl_FragColor = vec4(color.rgb / color.a, color.a);
+}
+)";
+}
+
+bool GridShader::build(const CellGrid& grid, float size) {
+    ready = false;
+    if (!sf::Shader::isAvailable()) {
+        cout << "Shaders no disponibles, se sigue dibujando con triangulos\n";
+        return false;
+    }
+    W = grid.width();
+    H = grid.height();
+    cellSize = size;
+    unsigned maxSize = sf::Texture::getMaximumSize();
+    if ((unsigned)W > maxSize || (unsigned)H > maxSize || !state.create(W, H)) {
+        cout << "El tablero no entra en una textura de " << maxSize << "x" << maxSize << "\n";
+        return false;
+    }
+    if (!shader.loadFromMemory(VERTEX_SHADER, FRAGMENT_SHADER)) {
+        cout << "Error al compilar el shader del tablero\n";
+        return false;
+    }
+    state.setSmooth(false);
+    shader.setUniform("state", state);
+    shader.setUniform("size", sf::Glsl::Vec2(float(W), float(H)));
+    shader.setUniform("cellSize", cellSize);
+    dirty.clear();
+    stale = true;
+    ready = true;
+    return true;
+}
+
+void GridShader::encode(const CellGrid& grid, int cell, uint8_t* texel) const {
+    texel[0] = uint8_t(grid.type(cell));
+    texel[1] = grid.has(CellFlag::Visited, cell) ? 255 : 0;
+    texel[2] = grid.has(CellFlag::Traversed, cell) ? 255 : 0;
+    texel[3] = grid.has(CellFlag::Reflected, cell) ? 255 : 0;
+}
+
+void GridShader::cellChanged(int cell) {
+    if (stale || !ready) return;
+    dirty.push_back(cell);
+    // Mientras se dibuja con triángulos la lista puede crecer sin límite
+    if ((long)dirty.size() > (long)W * H / 8) {
+        dirty.clear();
+        stale = true;
+    }
+}
+
+void GridShader::update(const CellGrid& grid, bool outlines) {
+    uploaded = 0;
+    shader.setUniform("outlines", outlines ? 1.f : 0.f);
+    if (stale) {
+        // Por bandas de filas para no tener el tablero entero dos veces en memoria
+        for (int y0 = 0; y0 < H; y0 += BAND) {
+            int rows = min(BAND, H - y0);
+            scratch.resize((size_t)W * rows * 4);
+            for (int i = 0; i < W * rows; ++i) encode(grid, y0 * W + i, &scratch[(size_t)i * 4]);
+            state.update(scratch.data(), W, rows, 0, y0);
+            uploaded += W * rows;
+        }
+        dirty.clear();
+        stale = false;
+        return;
+    }
+
+    // En orden, cada tramo de una fila con celdas cercanas va en una subida
+    sort(dirty.begin(), dirty.end());
+    dirty.erase(unique(dirty.begin(), dirty.end()), dirty.end());
+    for (size_t i = 0; i < dirty.size();) {
+        int from = dirty[i], to = from, row = from / W;
+        while (++i < dirty.size() && dirty[i] / W == row && dirty[i] - to <= MERGE_GAP) to = dirty[i];
+        int count = to - from + 1;
+        scratch.resize((size_t)count * 4);
+        for (int c = 0; c < count; ++c) encode(grid, from + c, &scratch[(size_t)c * 4]);
+        state.update(scratch.data(), count, 1, from % W, row);
+        uploaded += count;
+    }
+    dirty.clear();
+}
+
+void GridShader::draw(sf::RenderTarget& target, const sf::FloatRect& visible) const {
+    // Lo visible dentro del tablero, con una celda de más por los bordes de los triángulos
+    sf::FloatRect board(-cellSize, -cellSize, (W + 2) * cellSize, (H + 2) * cellSize);
+    sf::FloatRect area;
+    if (!board.intersects(visible, area)) return;
+    sf::Vertex quad[4] = {
+        sf::Vertex(sf::Vector2f(area.left, area.top)),
+        sf::Vertex(sf::Vector2f(area.left + area.width, area.top)),
+        sf::Vertex(sf::Vector2f(area.left, area.top + area.height)),
+        sf::Vertex(sf::Vector2f(area.left + area.width, area.top + area.height))
+    };
+    target.draw(quad, 4, sf::TriangleStrip, sf::RenderStates(&shader));
+}
@@ -0,0 +1,54 @@
+#include "GridSnapshot.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+GridSnapshot::GridSnapshot(const CellGrid& grid) : W(grid.width()), H(grid.height()) {
+    tilesX = (W + TILE - 1) / TILE;
+    tilesY = (H + TILE - 1) / TILE;
+    tiles.reserve(tilesX * tilesY);
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            auto tile = make_shared<Tile>();
+            // Lo que queda fuera del tablero en los bloques del borde es muro
+            fill(begin(tile->types), end(tile->types), uint8_t(CellType::Wall));
+            for (int y = ty * TILE; y < min(H, (ty + 1) * TILE); ++y) {
+                for (int x = tx * TILE; x < min(W, (tx + 1) * TILE); ++x) {
+                    tile->types[(y % TILE) * TILE + x % TILE] = uint8_t(grid.type(y*W + x));
+                }
+            }
+            tiles.push_back(move(tile));
+        }
+    }
+}
+
+GridSnapshot GridSnapshot::withTypes(const vector<pair<int, CellType>>& changes) const {
+    GridSnapshot next = *this;
+    next.serial = serial + 1;
+
+    // Cada bloque tocado se copia una sola vez; los demás siguen compartidos
+    vector<pair<int, shared_ptr<Tile>>> copies;
+    for (auto [cell, t] : changes) {
+        int x = cell % W, y = cell / W;
+        int index = (y / TILE) * tilesX + x / TILE;
+        auto it = find_if(copies.begin(), copies.end(), [&](const auto& c) { return c.first == index; });
+        if (it == copies.end()) {
+            copies.push_back({index, make_shared<Tile>(*tiles[index])});
+            it = copies.end() - 1;
+        }
+        it->second->types[(y % TILE) * TILE + x % TILE] = uint8_t(t);
+    }
+    for (auto& [index, tile] : copies) {
+        next.tiles[index] = move(tile);
+    }
+    return next;
+}
+
+int GridSnapshot::sharedTiles(const GridSnapshot& other) const {
+    int shared = 0;
+    for (size_t i = 0; i < min(tiles.size(), other.tiles.size()); ++i) {
+        shared += tiles[i] == other.tiles[i];
+    }
+    return shared;
+}
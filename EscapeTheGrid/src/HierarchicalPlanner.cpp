@@ -0,0 +1,361 @@
+#include "HierarchicalPlanner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <tuple>
+#include <unordered_set>
+
+using namespace std;
+
+namespace {
+    // Tramos de borde más largos que esto reciben dos entradas (en sus extremos)
+    const int LONG_ENTRANCE = 6;
+}
+
+void HierarchicalPlanner::invalidate() {
+    built = false;
+    pending.clear();
+}
+
+void HierarchicalPlanner::cellChanged(int x, int y) {
+    if (built) {
+        pending.push_back(y*W + x);
+    }
+}
+
+int HierarchicalPlanner::clusterOf(int cell) const {
+    return (cell / W / CLUSTER) * CW + (cell % W) / CLUSTER;
+}
+
+int HierarchicalPlanner::localNode(const Cluster& cluster, int cell) const {
+    auto it = lower_bound(cluster.nodes.begin(), cluster.nodes.end(), cell);
+    return (it != cluster.nodes.end() && *it == cell) ? int(it - cluster.nodes.begin()) : -1;
+}
+
+void HierarchicalPlanner::build(const CellGrid& grid) {
+    CW = (W + CLUSTER - 1) / CLUSTER;
+    CH = (H + CLUSTER - 1) / CLUSTER;
+    eastBorder.assign(CW * CH, {});
+    southBorder.assign(CW * CH, {});
+    clusters.assign(CW * CH, Cluster());
+    localOpen.assign(STRIDE * STRIDE, 0);
+    localDist.assign(STRIDE * STRIDE, -1);
+    localParent.assign(STRIDE * STRIDE, -1);
+    localQueue.assign(STRIDE * STRIDE, 0);
+    seen.assign(W * H, 0);
+    closed.assign(W * H, 0);
+    g.assign(W * H, 0);
+    parent.assign(W * H, -1);
+    epoch = 0;
+
+    for (int c = 0; c < CW * CH; ++c) {
+        Cluster& cluster = clusters[c];
+        cluster.x0 = (c % CW) * CLUSTER;
+        cluster.y0 = (c / CW) * CLUSTER;
+        cluster.x1 = min(W, cluster.x0 + CLUSTER);
+        cluster.y1 = min(H, cluster.y0 + CLUSTER);
+        buildBorder(grid, c, true);
+        buildBorder(grid, c, false);
+    }
+    for (int c = 0; c < CW * CH; ++c) {
+        buildCluster(grid, c);
+    }
+    pending.clear();
+    built = true;
+}
+
+// Entradas del borde este (o sur) del grupo: tramos donde ambos lados son libres
+void HierarchicalPlanner::buildBorder(const CellGrid& grid, int c, bool east) {
+    auto& border = east ? eastBorder[c] : southBorder[c];
+    border.clear();
+    const Cluster& cluster = clusters[c];
+    if (east ? cluster.x1 >= W : cluster.y1 >= H) return;
+
+    int length = east ? cluster.y1 - cluster.y0 : cluster.x1 - cluster.x0;
+    auto inside = [&](int k) {
+        return east ? (cluster.y0 + k) * W + cluster.x1 - 1 : (cluster.y1 - 1) * W + cluster.x0 + k;
+    };
+    int step = east ? 1 : W;
+
+    int runStart = -1;
+    for (int k = 0; k <= length; ++k) {
+        bool open = k < length && !grid.isWall(inside(k))
+                               && !grid.isWall(inside(k) + step);
+        if (open && runStart < 0) runStart = k;
+        if (!open && runStart >= 0) {
+            int runEnd = k - 1;
+            if (runEnd - runStart + 1 >= LONG_ENTRANCE) {
+                border.push_back({inside(runStart), inside(runStart) + step});
+                border.push_back({inside(runEnd), inside(runEnd) + step});
+            } else {
+                int mid = (runStart + runEnd) / 2;
+                border.push_back({inside(mid), inside(mid) + step});
+            }
+            runStart = -1;
+        }
+    }
+}
+
+// Nodos del grupo a partir de sus cuatro bordes y distancias internas entre ellos
+void HierarchicalPlanner::buildCluster(const CellGrid& grid, int c) {
+    Cluster& cluster = clusters[c];
+    int cx = c % CW, cy = c / CW;
+
+    vector<pair<int,int>> links;   // (nodo propio, nodo del vecino)
+    for (auto& t : eastBorder[c]) links.push_back(t);
+    for (auto& t : southBorder[c]) links.push_back(t);
+    if (cx > 0) for (auto& t : eastBorder[c - 1]) links.push_back({t.second, t.first});
+    if (cy > 0) for (auto& t : southBorder[c - CW]) links.push_back({t.second, t.first});
+
+    cluster.nodes.clear();
+    for (auto& l : links) cluster.nodes.push_back(l.first);
+    sort(cluster.nodes.begin(), cluster.nodes.end());
+    cluster.nodes.erase(unique(cluster.nodes.begin(), cluster.nodes.end()), cluster.nodes.end());
+
+    int n = cluster.nodes.size();
+    cluster.partners.assign(n, {});
+    for (auto& l : links) {
+        cluster.partners[localNode(cluster, l.first)].push_back(l.second);
+    }
+
+    cluster.dist.assign(n * n, -1);
+    clusterDistances(grid, cluster);
+}
+
+// Distancias entre todos los nodos del grupo. Cada fila del grupo cabe en una
+// palabra de 32 bits, así que el BFS avanza una capa entera con operaciones de bits
+void HierarchicalPlanner::clusterDistances(const CellGrid& grid, Cluster& cluster) {
+    int rows = cluster.y1 - cluster.y0;
+    uint32_t open[CLUSTER + 2] = {}, nodeMask[CLUSTER + 2] = {};
+    // x0 es múltiplo de 32: la fila del grupo sale de una sola palabra (y lo
+    // que pasa de W ya es cero en el tablero de transitabilidad)
+    for (int r = 0; r < rows; ++r) {
+        open[r + 1] = uint32_t(grid.openRow(cluster.y0 + r)[cluster.x0 >> 6] >> (cluster.x0 & 63));
+    }
+    int n = cluster.nodes.size();
+    for (int i = 0; i < n; ++i) {
+        int r = cluster.nodes[i] / W - cluster.y0, x = cluster.nodes[i] % W - cluster.x0;
+        nodeMask[r + 1] |= 1u << x;
+        nodeAt[r * CLUSTER + x] = i;
+    }
+
+    for (int i = 0; i < n; ++i) {
+        uint32_t visited[CLUSTER + 2] = {}, frontier[CLUSTER + 2] = {}, next[CLUSTER + 2] = {};
+        int r0 = cluster.nodes[i] / W - cluster.y0 + 1;
+        frontier[r0] = visited[r0] = 1u << (cluster.nodes[i] % W - cluster.x0);
+        cluster.dist[i*n + i] = 0;
+
+        int lo = r0, hi = r0, found = 1;
+        for (int d = 1; found < n && lo <= hi; ++d) {
+            int newLo = rows + 1, newHi = 0;
+            for (int r = max(1, lo - 1); r <= min(rows, hi + 1); ++r) {
+                uint32_t f = frontier[r];
+                next[r] = (f << 1 | f >> 1 | frontier[r - 1] | frontier[r + 1]) & open[r] & ~visited[r];
+                if (next[r]) {
+                    newLo = min(newLo, r);
+                    newHi = max(newHi, r);
+                }
+            }
+            for (int r = max(1, lo - 1); r <= min(rows, hi + 1); ++r) {
+                frontier[r] = next[r];
+                visited[r] |= next[r];
+                for (uint32_t hit = next[r] & nodeMask[r]; hit; hit &= hit - 1) {
+                    int j = nodeAt[(r - 1) * CLUSTER + __builtin_ctz(hit)];
+                    cluster.dist[i*n + j] = d;
+                    found++;
+                }
+            }
+            lo = newLo;
+            hi = newHi;
+        }
+    }
+}
+
+int HierarchicalPlanner::toLocal(const Cluster& cluster, int cell) const {
+    return (cell / W - cluster.y0 + 1) * STRIDE + cell % W - cluster.x0 + 1;
+}
+
+int HierarchicalPlanner::fromLocal(const Cluster& cluster, int local) const {
+    return (local / STRIDE - 1 + cluster.y0) * W + local % STRIDE - 1 + cluster.x0;
+}
+
+// Copia la transitabilidad del grupo con un marco de muros alrededor
+void HierarchicalPlanner::loadCluster(const CellGrid& grid, const Cluster& cluster) {
+    fill(localOpen.begin(), localOpen.end(), 0);
+    for (int y = cluster.y0; y < cluster.y1; ++y) {
+        for (int x = cluster.x0; x < cluster.x1; ++x) {
+            localOpen[(y - cluster.y0 + 1) * STRIDE + x - cluster.x0 + 1] = !grid.isWall(y*W + x);
+        }
+    }
+}
+
+// BFS dentro del grupo cargado con loadCluster() desde una celda suya
+void HierarchicalPlanner::localSearch(const Cluster& cluster, int source) {
+    fill(localDist.begin(), localDist.end(), -1);
+
+    int head = 0, tail = 0;
+    int s = toLocal(cluster, source);
+    localQueue[tail++] = s;
+    localDist[s] = 0;
+    localParent[s] = -1;
+    while (head < tail) {
+        int u = localQueue[head++];
+        int next[4] = { u + STRIDE, u - STRIDE, u + 1, u - 1 };
+        for (int v : next) {
+            if (!localOpen[v] || localDist[v] != -1) continue;
+            localDist[v] = localDist[u] + 1;
+            localParent[v] = u;
+            localQueue[tail++] = v;
+        }
+    }
+}
+
+int HierarchicalPlanner::localDistance(const Cluster& cluster, int cell) const {
+    return localDist[toLocal(cluster, cell)];
+}
+
+// Refinamiento de un tramo interno: agrega las celdas después de 'from' hasta 'to'
+void HierarchicalPlanner::appendLocalPath(const CellGrid& grid, int from, int to,
+                                          vector<pair<int,int>>& path) {
+    const Cluster& cluster = clusters[clusterOf(from)];
+    loadCluster(grid, cluster);
+    localSearch(cluster, from);
+
+    size_t mark = path.size();
+    int source = toLocal(cluster, from);
+    for (int c = toLocal(cluster, to); c != source; c = localParent[c]) {
+        int cell = fromLocal(cluster, c);
+        path.push_back({cell / W, cell % W});
+    }
+    reverse(path.begin() + mark, path.end());
+}
+
+bool HierarchicalPlanner::solve(const CellGrid& grid, int w, int h,
+                                int startX, int startY, int goalX, int goalY,
+                                vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    path.clear();
+
+    if (!built || w != W || h != H) {
+        W = w;
+        H = h;
+        build(grid);
+    }
+
+    // Cambios de tipo: una celda interior solo afecta a su grupo; una de borde
+    // cambia también las entradas compartidas con el grupo vecino
+    if (!pending.empty()) {
+        unordered_set<int> dirty;
+        for (int cell : pending) {
+            int c = clusterOf(cell);
+            const Cluster& cluster = clusters[c];
+            int x = cell % W, y = cell / W;
+            dirty.insert(c);
+            if (x == cluster.x1 - 1 && cluster.x1 < W) { buildBorder(grid, c, true); dirty.insert(c + 1); }
+            if (x == cluster.x0 && x > 0) { buildBorder(grid, c - 1, true); dirty.insert(c - 1); }
+            if (y == cluster.y1 - 1 && cluster.y1 < H) { buildBorder(grid, c, false); dirty.insert(c + CW); }
+            if (y == cluster.y0 && y > 0) { buildBorder(grid, c - CW, false); dirty.insert(c - CW); }
+        }
+        for (int c : dirty) buildCluster(grid, c);
+        pending.clear();
+    }
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    int startCluster = clusterOf(start);
+    int goalCluster = clusterOf(goal);
+
+    // Conexión temporal del inicio y la meta con las entradas de su grupo
+    const Cluster& sc = clusters[startCluster];
+    const Cluster& gc = clusters[goalCluster];
+    loadCluster(grid, sc);
+    localSearch(sc, start);
+    vector<int> startDist(sc.nodes.size());
+    for (size_t k = 0; k < sc.nodes.size(); ++k) startDist[k] = localDistance(sc, sc.nodes[k]);
+    int direct = startCluster == goalCluster ? localDistance(sc, goal) : -1;
+    loadCluster(grid, gc);
+    localSearch(gc, goal);
+    vector<int> goalDist(gc.nodes.size());
+    for (size_t k = 0; k < gc.nodes.size(); ++k) goalDist[k] = localDistance(gc, gc.nodes[k]);
+
+    auto heuristic = [&](int c) { return abs(c % W - goalX) + abs(c / W - goalY); };
+    auto forEachEdge = [&](int u, const function<void(int,int)>& visit) {
+        int c = clusterOf(u);
+        const Cluster& cluster = clusters[c];
+        int k = localNode(cluster, u);
+        if (u == start) {
+            for (size_t j = 0; j < sc.nodes.size(); ++j) {
+                if (startDist[j] > 0) visit(sc.nodes[j], startDist[j]);
+            }
+            if (direct >= 0) visit(goal, direct);
+        } else if (k >= 0) {
+            int n = cluster.nodes.size();
+            for (int j = 0; j < n; ++j) {
+                if (cluster.dist[k*n + j] > 0) visit(cluster.nodes[j], cluster.dist[k*n + j]);
+            }
+            if (c == goalCluster && goalDist[k] >= 0) visit(goal, goalDist[k]);
+        }
+        if (k >= 0) {
+            for (int p : cluster.partners[k]) visit(p, 1);
+        }
+    };
+
+    // A* sobre el grafo abstracto. Empates de f: primero el de mayor g
+    if (++epoch == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        fill(closed.begin(), closed.end(), 0);
+        epoch = 1;
+    }
+    using Entry = tuple<int,int,int>;   // (f, -g, celda)
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+    seen[start] = epoch;
+    g[start] = 0;
+    parent[start] = -1;
+    open.push({heuristic(start), 0, start});
+
+    bool found = start == goal;
+    while (!open.empty() && !found) {
+        int u = get<2>(open.top());
+        open.pop();
+        if (closed[u] == epoch) continue;
+        closed[u] = epoch;
+        stats.expanded++;
+        if (u == goal) {
+            found = true;
+            break;
+        }
+        forEachEdge(u, [&](int v, int cost) {
+            if (closed[v] == epoch) return;
+            if (seen[v] == epoch && g[v] <= g[u] + cost) return;
+            seen[v] = epoch;
+            g[v] = g[u] + cost;
+            parent[v] = u;
+            open.push({g[v] + heuristic(v), -g[v], v});
+        });
+        stats.peakOpen = max(stats.peakOpen, (int)open.size());
+    }
+
+    if (found) {
+        vector<int> route;
+        for (int c = goal; c != -1; c = parent[c]) route.push_back(c);
+        reverse(route.begin(), route.end());
+
+        // Refinamiento: las aristas entre grupos son un paso, las internas un BFS local
+        path.push_back({startY, startX});
+        for (size_t i = 1; i < route.size(); ++i) {
+            int a = route[i - 1], b = route[i];
+            if (clusterOf(a) != clusterOf(b)) {
+                path.push_back({b / W, b % W});
+            } else {
+                appendLocalPath(grid, a, b, path);
+            }
+        }
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
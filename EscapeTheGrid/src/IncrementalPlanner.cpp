@@ -0,0 +1,179 @@
+#include "IncrementalPlanner.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+using namespace std;
+
+namespace {
+    const int INF = numeric_limits<int>::max() / 4;
+    const int dirs[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
+}
+
+void IncrementalPlanner::invalidate() {
+    initialized = false;
+    pending.clear();
+}
+
+void IncrementalPlanner::cellChanged(int x, int y) {
+    // Sin estado previo no hay nada que reparar: la próxima llamada parte de cero
+    if (initialized) {
+        pending.push_back(y*W + x);
+    }
+}
+
+void IncrementalPlanner::initialize(int w, int h, int s, int t) {
+    W = w;
+    H = h;
+    g.assign(W * H, INF);
+    rhs.assign(W * H, INF);
+    open = {};
+    pending.clear();
+    km = 0;
+    start = lastStart = s;
+    goal = t;
+
+    rhs[goal] = 0;
+    open.push({calculateKey(goal), goal});
+    initialized = true;
+}
+
+int IncrementalPlanner::heuristic(int a, int b) const {
+    return abs(a % W - b % W) + abs(a / W - b / W);
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculateKey(int s) const {
+    int m = min(g[s], rhs[s]);
+    return {m + heuristic(start, s) + km, m};
+}
+
+void IncrementalPlanner::updateVertex(const CellGrid& grid, int u) {
+    if (u != goal) {
+        // Igual que en bfsSolve(): un muro bloquea la entrada, no la salida
+        int y = u / W, x = u % W;
+        int best = INF;
+        for (auto& d : dirs) {
+            int ny = y + d[0];
+            int nx = x + d[1];
+            if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+            int v = ny*W + nx;
+            if (grid.isWall(v) || g[v] >= INF) continue;
+            best = min(best, g[v] + 1);
+        }
+        rhs[u] = best;
+    }
+    if (g[u] != rhs[u]) {
+        open.push({calculateKey(u), u});
+    }
+}
+
+void IncrementalPlanner::computeShortestPath(const CellGrid& grid) {
+    while (!open.empty()) {
+        Entry top = open.top();
+        int u = top.cell;
+
+        // Entradas obsoletas: la celda ya es consistente
+        if (g[u] == rhs[u]) {
+            open.pop();
+            continue;
+        }
+        if (!(top.key < calculateKey(start)) && rhs[start] == g[start]) break;
+        open.pop();
+
+        Key current = calculateKey(u);
+        if (top.key < current) {
+            open.push({current, u});
+            continue;
+        }
+
+        expanded++;
+        if (g[u] > rhs[u]) {
+            g[u] = rhs[u];
+        } else {
+            g[u] = INF;
+            updateVertex(grid, u);
+        }
+
+        // Nadie puede entrar a un muro, sus vecinos no dependen de él
+        if (grid.isWall(u)) continue;
+
+        int y = u / W, x = u % W;
+        for (auto& d : dirs) {
+            int ny = y + d[0];
+            int nx = x + d[1];
+            if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+            updateVertex(grid, ny*W + nx);
+        }
+    }
+}
+
+bool IncrementalPlanner::replan(const CellGrid& grid, int w, int h,
+                                int startX, int startY, int goalX, int goalY,
+                                vector<pair<int,int>>& path) {
+    expanded = 0;
+    path.clear();
+
+    int s = startY*w + startX;
+    int t = goalY*w + goalX;
+
+    if (!initialized || w != W || h != H) {
+        initialize(w, h, s, t);
+    } else {
+        // El jugador avanzó: las claves viejas siguen siendo cotas inferiores
+        if (s != lastStart) {
+            km += heuristic(lastStart, s);
+            lastStart = s;
+        }
+        start = s;
+
+        // La meta se movió: la vieja pasa a ser una celda normal y la nueva es la raíz
+        if (t != goal) {
+            int oldGoal = goal;
+            goal = t;
+            updateVertex(grid, oldGoal);
+            rhs[goal] = 0;
+            updateVertex(grid, goal);
+        }
+
+        // Celdas que cambiaron de tipo: cambian las aristas que entran en ellas
+        for (int c : pending) {
+            int y = c / W, x = c % W;
+            updateVertex(grid, c);
+            for (auto& d : dirs) {
+                int ny = y + d[0];
+                int nx = x + d[1];
+                if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+                updateVertex(grid, ny*W + nx);
+            }
+        }
+        pending.clear();
+    }
+
+    computeShortestPath(grid);
+
+    if (g[start] >= INF) return false;
+
+    // Descenso por g desde el inicio hasta la meta
+    int cur = start;
+    path.push_back({cur / W, cur % W});
+    while (cur != goal) {
+        int y = cur / W, x = cur % W;
+        int next = -1;
+        for (auto& d : dirs) {
+            int ny = y + d[0];
+            int nx = x + d[1];
+            if (nx < 0 || nx >= W || ny < 0 || ny >= H) continue;
+            int v = ny*W + nx;
+            if (grid.isWall(v)) continue;
+            if (next == -1 || g[v] < g[next]) next = v;
+        }
+        if (next == -1 || g[next] >= g[cur]) {
+            path.clear();
+            return false;
+        }
+        cur = next;
+        path.push_back({cur / W, cur % W});
+    }
+    return true;
+}
@@ -0,0 +1,142 @@
+#include "JumpPointSearch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+void JumpPointSearch::resize(int w, int h) {
+    if (w == W && h == H) return;
+    W = w;
+    H = h;
+    seen.assign(W * H, 0);
+    closed.assign(W * H, 0);
+    g.assign(W * H, 0);
+    parent.assign(W * H, -1);
+    arrivalX.assign(W * H, 0);
+    arrivalY.assign(W * H, 0);
+    epoch = 0;
+    stats.allocations += 6;
+}
+
+bool JumpPointSearch::blocked(int x, int y) const {
+    return !grid->passable(x, y);
+}
+
+int JumpPointSearch::jumpVertical(int x, int y, int dy) const {
+    while (true) {
+        y += dy;
+        if (blocked(x, y)) return -1;
+        if (x == goalX && y == goalY) return y*W + x;
+        // Vecino forzado: el lateral está libre pero no se llega a él
+        // por el camino canónico (horizontal y luego vertical)
+        if ((!blocked(x - 1, y) && blocked(x - 1, y - dy)) ||
+            (!blocked(x + 1, y) && blocked(x + 1, y - dy))) {
+            return y*W + x;
+        }
+    }
+}
+
+int JumpPointSearch::jumpHorizontal(int x, int y, int dx) const {
+    while (true) {
+        x += dx;
+        if (blocked(x, y)) return -1;
+        if (x == goalX && y == goalY) return y*W + x;
+        if (jumpVertical(x, y, 1) != -1 || jumpVertical(x, y, -1) != -1) {
+            return y*W + x;
+        }
+    }
+}
+
+void JumpPointSearch::push(int from, int to, int8_t dx, int8_t dy) {
+    if (to < 0 || closed[to] == epoch) return;
+    int cost = g[from] + abs(to % W - from % W) + abs(to / W - from / W);
+    if (seen[to] == epoch && g[to] <= cost) return;
+    seen[to] = epoch;
+    g[to] = cost;
+    parent[to] = from;
+    arrivalX[to] = dx;
+    arrivalY[to] = dy;
+    open.push(cost + abs(to % W - goalX) + abs(to / W - goalY), to);
+}
+
+bool JumpPointSearch::solve(const CellGrid& cells, int w, int h,
+                            int startX, int startY, int gx, int gy,
+                            vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    resize(w, h);
+    path.clear();
+    open.clear();
+    grid = &cells;
+    goalX = gx;
+    goalY = gy;
+
+    if (++epoch == 0) {
+        fill(seen.begin(), seen.end(), 0);
+        fill(closed.begin(), closed.end(), 0);
+        epoch = 1;
+    }
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    seen[start] = epoch;
+    g[start] = 0;
+    parent[start] = -1;
+    arrivalX[start] = arrivalY[start] = 0;
+    open.push(abs(startX - goalX) + abs(startY - goalY), start);
+    stats.peakOpen = 1;
+
+    bool found = false;
+    while (!open.empty()) {
+        int u = open.pop();
+        if (closed[u] == epoch) continue;
+        closed[u] = epoch;
+        stats.expanded++;
+
+        if (u == goal) {
+            found = true;
+            break;
+        }
+
+        int x = u % W, y = u / W;
+        int dx = arrivalX[u], dy = arrivalY[u];
+        if (dx == 0 && dy == 0) {
+            // Inicio: las cuatro direcciones
+            push(u, jumpHorizontal(x, y, 1), 1, 0);
+            push(u, jumpHorizontal(x, y, -1), -1, 0);
+            push(u, jumpVertical(x, y, 1), 0, 1);
+            push(u, jumpVertical(x, y, -1), 0, -1);
+        } else if (dx != 0) {
+            push(u, jumpHorizontal(x, y, dx), dx, 0);
+            push(u, jumpVertical(x, y, 1), 0, 1);
+            push(u, jumpVertical(x, y, -1), 0, -1);
+        } else {
+            push(u, jumpVertical(x, y, dy), 0, dy);
+            for (int side : {-1, 1}) {
+                if (!blocked(x + side, y) && blocked(x + side, y - dy)) {
+                    push(u, jumpHorizontal(x, y, side), side, 0);
+                }
+            }
+        }
+        stats.peakOpen = max(stats.peakOpen, open.size());
+    }
+
+    if (found) {
+        // Los puntos de salto están alineados: se rellena cada tramo recto
+        for (int c = goal; parent[c] != -1; c = parent[c]) {
+            int p = parent[c];
+            int sx = (p % W > c % W) - (p % W < c % W);
+            int sy = (p / W > c / W) - (p / W < c / W);
+            for (int cx = c % W, cy = c / W; cx != p % W || cy != p / W; cx += sx, cy += sy) {
+                path.push_back({cy, cx});
+            }
+        }
+        path.push_back({startY, startX});
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
@@ -0,0 +1,47 @@
+#include "MazeLoader.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+bool loadMazeFile(const string& path, CellGrid& grid, MazeInfo& maze) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        cout << "No se pudo abrir: " << path << endl;
+        return false;
+    }
+
+    if (!(file >> maze.W >> maze.H >> maze.startY >> maze.startX >> maze.goalY >> maze.goalX)) {
+        cout << "Error leyendo dimensiones del laberinto" << endl;
+        return false;
+    }
+
+    int W = maze.W, H = maze.H;
+    grid.resize(W, H);
+    string line;
+    getline(file, line);
+
+    for (int y = 0; y < H; y++) {
+        if (!getline(file, line)) {
+            cout << "Error leyendo linea " << y << endl;
+            return false;
+        }
+        istringstream iss(line);
+        for (int x = 0; x < W; x++) {
+            string t;
+            if (!(iss >> t)) {
+                cout << "Error leyendo celda [" << x << "," << y << "]" << endl;
+                return false;
+            }
+            if (t == "#") grid.setType(y*W + x, CellType::Wall);
+            else if (t == "S") grid.setType(y*W + x, CellType::Start);
+            else if (t == "G") grid.setType(y*W + x, CellType::Goal);
+            else if (t == "C" || t == "K") grid.setType(y*W + x, CellType::Crystal);
+            else grid.setType(y*W + x, CellType::Empty);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,239 @@
+#include "MirrorKernel.hpp"
+
+#include <algorithm>
+
+// -DETG_NO_AVX2 deja solo las versiones escalares, para probarlas en una CPU con AVX2
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(ETG_NO_AVX2)
+#include <immintrin.h>
+#define ETG_AVX2_KERNEL 1
+#endif
+
+using namespace std;
+
+namespace {
+
+    // out[w] = los 64 bits de src que empiezan en el bit (w + q)*64 + r, w en [from, to)
+    void shiftedScalar(const uint64_t* src, int q, int r, uint64_t* out, int from, int to) {
+        for (int w = from; w < to; ++w) {
+            uint64_t lo = src[w + q] >> r;
+            uint64_t hi = r ? src[w + q + 1] << (64 - r) : 0;
+            out[w] = lo | hi;
+        }
+    }
+
+    // Reflejo sobre una fila: mirrored |= m, lo no muro pasa a reflejado y
+    // recorrido, y en span quedan solo las celdas recién recorridas
+    void applyScalar(uint64_t* span, const uint64_t* open, uint64_t* traversed,
+                     uint64_t* reflected, uint64_t* mirrored, int from, int to) {
+        for (int w = from; w < to; ++w) {
+            uint64_t m = span[w];
+            uint64_t n = m & open[w];
+            mirrored[w] |= m;
+            reflected[w] |= n;
+            span[w] = n & ~traversed[w];
+            traversed[w] |= n;
+        }
+    }
+
+#ifdef ETG_AVX2_KERNEL
+    __attribute__((target("avx2")))
+    void shiftedAvx2(const uint64_t* src, int q, int r, uint64_t* out, int from, int to) {
+        // Un corrimiento de 64 da 0 con sll, que es justo lo que hace falta con r = 0
+        __m128i right = _mm_cvtsi32_si128(r), left = _mm_cvtsi32_si128(64 - r);
+        int w = from;
+        for (; w + 4 <= to; w += 4) {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(src + w + q));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src + w + q + 1));
+            __m256i v = _mm256_or_si256(_mm256_srl_epi64(a, right), _mm256_sll_epi64(b, left));
+            _mm256_storeu_si256((__m256i*)(out + w), v);
+        }
+        shiftedScalar(src, q, r, out, w, to);
+    }
+
+    __attribute__((target("avx2")))
+    void applyAvx2(uint64_t* span, const uint64_t* open, uint64_t* traversed,
+                   uint64_t* reflected, uint64_t* mirrored, int from, int to) {
+        int w = from;
+        for (; w + 4 <= to; w += 4) {
+            __m256i m = _mm256_loadu_si256((const __m256i*)(span + w));
+            __m256i n = _mm256_and_si256(m, _mm256_loadu_si256((const __m256i*)(open + w)));
+            __m256i t = _mm256_loadu_si256((const __m256i*)(traversed + w));
+            _mm256_storeu_si256((__m256i*)(mirrored + w),
+                _mm256_or_si256(m, _mm256_loadu_si256((const __m256i*)(mirrored + w))));
+            _mm256_storeu_si256((__m256i*)(reflected + w),
+                _mm256_or_si256(n, _mm256_loadu_si256((const __m256i*)(reflected + w))));
+            _mm256_storeu_si256((__m256i*)(span + w), _mm256_andnot_si256(t, n));
+            _mm256_storeu_si256((__m256i*)(traversed + w), _mm256_or_si256(t, n));
+        }
+        applyScalar(span, open, traversed, reflected, mirrored, w, to);
+    }
+
+    const bool hasAvx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    void shifted(const uint64_t* src, int q, int r, uint64_t* out, int from, int to) {
+#ifdef ETG_AVX2_KERNEL
+        if (hasAvx2) {
+            shiftedAvx2(src, q, r, out, from, to);
+            return;
+        }
+#endif
+        shiftedScalar(src, q, r, out, from, to);
+    }
+
+    void apply(uint64_t* span, const uint64_t* open, uint64_t* traversed,
+               uint64_t* reflected, uint64_t* mirrored, int from, int to) {
+#ifdef ETG_AVX2_KERNEL
+        if (hasAvx2) {
+            applyAvx2(span, open, traversed, reflected, mirrored, from, to);
+            return;
+        }
+#endif
+        applyScalar(span, open, traversed, reflected, mirrored, from, to);
+    }
+
+    void setBit(uint64_t* plane, long i) { plane[i >> 6] |= 1ull << (i & 63); }
+    bool testBit(const uint64_t* plane, long i) { return (plane[i >> 6] >> (i & 63)) & 1; }
+
+    // OR de 64 bits en un plano y*W + x a partir del bit 'pos'
+    void storeBits(uint64_t* plane, int words, long pos, uint64_t v) {
+        long q = pos >> 6;
+        int r = pos & 63;
+        plane[q] |= v << r;
+        if (r && q + 1 < words) plane[q + 1] |= v >> (64 - r);
+    }
+
+    // Reserva un plano con una palabra de guarda a cada lado; devuelve el inicio útil
+    uint64_t* guarded(vector<uint64_t>& plane, long words) {
+        plane.assign(words + 2, 0);
+        return plane.data() + 1;
+    }
+
+    // Palabras [lo/64, hi/64] con los bits fuera de [lo, hi] en cero
+    void clipRange(uint64_t* line, int lo, int hi) {
+        int first = lo >> 6, last = hi >> 6;
+        line[first] &= ~0ull << (lo & 63);
+        line[last] &= ~0ull >> (63 - (hi & 63));
+    }
+}
+
+// Marca (x,y) como recorrida en las cuatro vistas
+void MirrorKernel::setTraversed(int x, int y) {
+    setBit(rows.data() + 1, (long)y * rowWords * 64 + x);
+    setBit(rowsRev.data() + 1, (long)y * rowWords * 64 + rowWords * 64 - 1 - x);
+    setBit(cols.data() + 1, (long)x * colWords * 64 + y);
+    setBit(colsRev.data() + 1, (long)x * colWords * 64 + colWords * 64 - 1 - y);
+}
+
+void MirrorKernel::run(CellGrid& grid, const vector<vector<int>>& rowCrystals,
+                       vector<uint64_t>& mirrored) {
+    W = grid.width();
+    H = grid.height();
+    rowWords = (W + 63) / 64;
+    colWords = (H + 63) / 64;
+    int PW = rowWords * 64, PH = colWords * 64;
+
+    uint64_t* openR = guarded(openRows, (long)H * rowWords);
+    uint64_t* openC = guarded(openCols, (long)W * colWords);
+    uint64_t* rowT = guarded(rows, (long)H * rowWords);
+    guarded(rowsRev, (long)H * rowWords);
+    uint64_t* colT = guarded(cols, (long)W * colWords);
+    uint64_t* colRev = guarded(colsRev, (long)W * colWords);
+    uint64_t* rowR = guarded(reflectedRows, (long)H * rowWords);
+    uint64_t* rowM = guarded(mirroredRows, (long)H * rowWords);
+    uint64_t* rowRev = rowsRev.data() + 1;
+    span.assign(max(rowWords, colWords), 0);
+
+    // Muros y recorridos actuales en las vistas por fila y por columna
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (!grid.isWall(y*W + x)) {
+                setBit(openR, (long)y * PW + x);
+                setBit(openC, (long)x * PH + y);
+            }
+        }
+    }
+    const uint64_t* traversed = grid.flagData(CellFlag::Traversed);
+    for (int w = 0; w < grid.flagWords(); ++w) {
+        for (uint64_t bits = traversed[w]; bits; bits &= bits - 1) {
+            int cell = w * 64 + __builtin_ctzll(bits);
+            setTraversed(cell % W, cell / W);
+        }
+    }
+
+    for (int cy = 0; cy < H; ++cy) {
+        for (int cx : rowCrystals[cy]) {
+            // Fila: el destino t refleja al origen 2cx - t, que en la fila
+            // invertida es el bit PW-1-2cx+t; o sea, la fila invertida corrida
+            int lo = cx + 1, hi = min(2 * cx, W - 1);
+            if (lo <= hi) {
+                int k = PW - 1 - 2 * cx;
+                int q = k >= 0 ? k / 64 : -((-k + 63) / 64);
+                uint64_t* line = rowT + (long)cy * rowWords;
+                int first = lo >> 6, last = (hi >> 6) + 1;
+                shifted(rowRev + (long)cy * rowWords, q, k - 64 * q, span.data(), first, last);
+                clipRange(span.data(), lo, hi);
+                apply(span.data(), openR + (long)cy * rowWords, line,
+                      rowR + (long)cy * rowWords, rowM + (long)cy * rowWords, first, last);
+                for (int w = first; w < last; ++w) {
+                    for (uint64_t bits = span[w]; bits; bits &= bits - 1) {
+                        int x = w * 64 + __builtin_ctzll(bits);
+                        setBit(rowRev, (long)cy * PW + PW - 1 - x);
+                        setBit(colT, (long)x * PH + cy);
+                        setBit(colRev, (long)x * PH + PH - 1 - cy);
+                    }
+                }
+            }
+
+            // Columna: lo mismo sobre la vista transpuesta
+            lo = cy + 1;
+            hi = min(2 * cy, H - 1);
+            if (lo <= hi) {
+                int k = PH - 1 - 2 * cy;
+                int q = k >= 0 ? k / 64 : -((-k + 63) / 64);
+                int first = lo >> 6, last = (hi >> 6) + 1;
+                shifted(colRev + (long)cx * colWords, q, k - 64 * q, span.data(), first, last);
+                clipRange(span.data(), lo, hi);
+                const uint64_t* open = openC + (long)cx * colWords;
+                for (int w = first; w < last; ++w) {
+                    for (uint64_t bits = span[w]; bits; bits &= bits - 1) {
+                        int y = w * 64 + __builtin_ctzll(bits);
+                        setBit(rowM, (long)y * PW + cx);
+                        if (!testBit(open, y)) continue;
+                        setBit(rowR, (long)y * PW + cx);
+                        if (!testBit(rowT, (long)y * PW + cx)) setTraversed(cx, y);
+                    }
+                }
+            }
+        }
+    }
+
+    // De vuelta al plano y*W + x de la grilla. Traversed y Reflected se tocan
+    // solo donde cambian y con set()/reset(), así el diario de la grilla los ve
+    int words = grid.flagWords();
+    const uint64_t* oldR = grid.flagData(CellFlag::Reflected);
+    for (int w = 0; w < words; ++w) {
+        for (uint64_t bits = oldR[w]; bits; bits &= bits - 1) {
+            int cell = w * 64 + __builtin_ctzll(bits);
+            if (!testBit(rowR, (long)(cell / W) * PW + cell % W)) grid.reset(CellFlag::Reflected, cell);
+        }
+    }
+    mirrored.assign(words, 0);
+    for (int y = 0; y < H; ++y) {
+        for (int w = 0; w < rowWords; ++w) {
+            long pos = (long)y * W + w * 64;
+            int count = min(64, W - w * 64);
+            uint64_t mask = count < 64 ? (1ull << count) - 1 : ~0ull;
+            long src = (long)y * rowWords + w;
+            for (uint64_t bits = rowT[src] & mask; bits; bits &= bits - 1) {
+                int cell = int(pos + __builtin_ctzll(bits));
+                if (!grid.has(CellFlag::Traversed, cell)) grid.set(CellFlag::Traversed, cell);
+            }
+            for (uint64_t bits = rowR[src] & mask; bits; bits &= bits - 1) {
+                int cell = int(pos + __builtin_ctzll(bits));
+                if (!grid.has(CellFlag::Reflected, cell)) grid.set(CellFlag::Reflected, cell);
+            }
+            storeBits(mirrored.data(), words, pos, rowM[src] & mask);
+        }
+    }
+}
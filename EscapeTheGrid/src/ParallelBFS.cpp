@@ -0,0 +1,104 @@
+#include "ParallelBFS.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace {
+    // Frentes más chicos que esto se expanden en un solo hilo
+    const int MIN_PARALLEL_FRONTIER = 4096;
+    // Celdas del frente por tarea
+    const int CHUNK = 1024;
+}
+
+void ParallelBFS::resize(int w, int h) {
+    if ((int)local.size() < pool.size()) {
+        local.resize(pool.size());
+        stats.allocations++;
+    }
+    if (w == W && h == H) return;
+    W = w;
+    H = h;
+    visited.reset(new atomic<uint64_t>[(W * H + 63) / 64]);
+    level.assign(W * H, 0);
+    frontier.reserve(W * H);
+    next.reserve(W * H);
+    stats.allocations += 4;
+}
+
+bool ParallelBFS::solve(const CellGrid& grid, int w, int h,
+                        int startX, int startY, int goalX, int goalY,
+                        vector<pair<int,int>>& path) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    resize(w, h);
+    path.clear();
+
+    int words = (W * H + 63) / 64;
+    for (int i = 0; i < words; ++i) visited[i].store(0, memory_order_relaxed);
+
+    int start = startY*W + startX;
+    int goal = goalY*W + goalX;
+    visited[start / 64].store(1ull << (start % 64), memory_order_relaxed);
+    level[start] = 0;
+    frontier.assign(1, start);
+
+    // Expande frontier[begin, end) y deja las celdas nuevas en 'out'
+    auto expand = [&](int begin, int end, int d, vector<int32_t>& out) {
+        for (int k = begin; k < end; ++k) {
+            int u = frontier[k];
+            int step[4] = { W, -W, 1, -1 };
+            for (int mask = grid.passableMask(u); mask; mask &= mask - 1) {
+                int v = u + step[__builtin_ctz(mask)];
+                uint64_t bit = 1ull << (v % 64);
+                atomic<uint64_t>& word = visited[v / 64];
+                if (word.load(memory_order_relaxed) & bit) continue;
+                if (word.fetch_or(bit, memory_order_relaxed) & bit) continue;
+                level[v] = d;
+                out.push_back(v);
+            }
+        }
+    };
+
+    bool found = start == goal;
+    for (int d = 1; !found && !frontier.empty(); ++d) {
+        stats.expanded += frontier.size();
+        stats.peakOpen = max(stats.peakOpen, (int)frontier.size());
+        int n = frontier.size();
+        next.clear();
+        if (n < MIN_PARALLEL_FRONTIER || pool.size() == 1) {
+            expand(0, n, d, next);
+        } else {
+            for (auto& l : local) l.clear();
+            pool.run((n + CHUNK - 1) / CHUNK, [&](int task, int thread) {
+                expand(task * CHUNK, min(n, (task + 1) * CHUNK), d, local[thread]);
+            });
+            for (auto& l : local) next.insert(next.end(), l.begin(), l.end());
+        }
+        frontier.swap(next);
+        found = (visited[goal / 64].load(memory_order_relaxed) >> (goal % 64)) & 1;
+    }
+
+    if (found) {
+        // Desde la meta, el vecino del nivel anterior con menor índice
+        auto isVisited = [&](int c) { return (visited[c / 64].load(memory_order_relaxed) >> (c % 64)) & 1; };
+        for (int c = goal; ; ) {
+            path.push_back({c / W, c % W});
+            if (c == start) break;
+            int y = c / W, x = c % W;
+            int nbr[4] = { y > 0 ? c - W : -1, x > 0 ? c - 1 : -1,
+                           x + 1 < W ? c + 1 : -1, y + 1 < H ? c + W : -1 };
+            for (int p : nbr) {
+                if (p >= 0 && isVisited(p) && level[p] == level[c] - 1) {
+                    c = p;
+                    break;
+                }
+            }
+        }
+        reverse(path.begin(), path.end());
+    }
+
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+    return found;
+}
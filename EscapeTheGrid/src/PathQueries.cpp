@@ -0,0 +1,104 @@
+#include "PathQueries.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+void PathQueries::solve(const GridSnapshot& grid, const vector<PathQuery>& queries, vector<int>& lengths) {
+    lengths.resize(queries.size());
+    solve(grid, queries.data(), queries.size(), lengths.data());
+}
+
+void PathQueries::solve(const GridSnapshot& grid, const PathQuery* queries, size_t count, int* lengths) {
+    auto t0 = chrono::steady_clock::now();
+    stats = SolveStats();
+    int W = grid.width();
+
+    // Consultas ordenadas por celda de inicio; cada tramo con el mismo inicio es un grupo
+    auto source = [&](int q) { return queries[q].startY * W + queries[q].startX; };
+    order.resize(count);
+    for (size_t q = 0; q < count; ++q) order[q] = q;
+    sort(order.begin(), order.end(), [&](int a, int b) { return source(a) < source(b); });
+    groups.clear();
+    for (size_t k = 0; k < count; ++k) {
+        if (k == 0 || source(order[k]) != source(order[k - 1])) groups.push_back(k);
+    }
+    groups.push_back(count);
+
+    if ((int)workspaces.size() < pool.size()) workspaces.resize(pool.size());
+    for (auto& ws : workspaces) {
+        ws.expanded = 0;
+        ws.allocations = 0;
+    }
+
+    pool.run((int)groups.size() - 1, [&](int g, int thread) {
+        solveGroup(grid, queries, order.data() + groups[g], groups[g + 1] - groups[g],
+                   lengths, workspaces[thread]);
+    });
+
+    for (auto& ws : workspaces) {
+        stats.expanded += ws.expanded;
+        stats.allocations += ws.allocations;
+    }
+    stats.nanos = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - t0).count();
+}
+
+// Un BFS desde el inicio común del grupo, hasta encontrar todas sus metas
+void PathQueries::solveGroup(const GridSnapshot& grid, const PathQuery* queries, const int* members,
+                             int count, int* lengths, Workspace& ws) {
+    int W = grid.width(), H = grid.height();
+    if ((int)ws.stamp.size() != W * H) {
+        ws.stamp.assign(W * H, 0);
+        ws.target.assign(W * H, 0);
+        ws.dist.assign(W * H, 0);
+        ws.queue.assign(W * H, 0);
+        ws.epoch = 0;
+        ws.allocations += 4;
+    }
+    if (++ws.epoch == 0) {
+        fill(ws.stamp.begin(), ws.stamp.end(), 0);
+        fill(ws.target.begin(), ws.target.end(), 0);
+        ws.epoch = 1;
+    }
+
+    int remaining = 0;
+    for (int k = 0; k < count; ++k) {
+        const PathQuery& q = queries[members[k]];
+        int goal = q.goalY * W + q.goalX;
+        if (ws.target[goal] != ws.epoch) {
+            ws.target[goal] = ws.epoch;
+            remaining++;
+        }
+    }
+
+    int start = queries[members[0]].startY * W + queries[members[0]].startX;
+    int head = 0, tail = 0;
+    ws.queue[tail++] = start;
+    ws.stamp[start] = ws.epoch;
+    ws.dist[start] = 0;
+    if (ws.target[start] == ws.epoch) remaining--;
+
+    while (head < tail && remaining > 0) {
+        int u = ws.queue[head++];
+        int y = u / W, x = u % W;
+        int next[4] = { y + 1 < H ? u + W : -1, y > 0 ? u - W : -1,
+                        x + 1 < W ? u + 1 : -1, x > 0 ? u - 1 : -1 };
+        int nx[4] = { x, x, x + 1, x - 1 }, ny[4] = { y + 1, y - 1, y, y };
+        for (int k = 0; k < 4; ++k) {
+            int v = next[k];
+            if (v < 0 || ws.stamp[v] == ws.epoch || grid.isWall(nx[k], ny[k])) continue;
+            ws.stamp[v] = ws.epoch;
+            ws.dist[v] = ws.dist[u] + 1;
+            ws.queue[tail++] = v;
+            if (ws.target[v] == ws.epoch) remaining--;
+        }
+    }
+    ws.expanded += head;
+
+    for (int k = 0; k < count; ++k) {
+        const PathQuery& q = queries[members[k]];
+        int goal = q.goalY * W + q.goalX;
+        lengths[members[k]] = ws.stamp[goal] == ws.epoch ? ws.dist[goal] : -1;
+    }
+}
@@ -0,0 +1,66 @@
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    for (int t = 1; t < threads; ++t) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, t);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<std::mutex> lock(guard);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+// Toma tareas del contador compartido hasta agotarlas
+void ThreadPool::drain(int thread) {
+    for (int t = nextTask++; t < jobTasks; t = nextTask++) {
+        (*job)(t, thread);
+    }
+}
+
+void ThreadPool::workerLoop(int thread) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            unique_lock<std::mutex> lock(guard);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drain(thread);
+        {
+            lock_guard<std::mutex> lock(guard);
+            if (--busy == 0) done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(int tasks, const function<void(int,int)>& fn) {
+    if (tasks <= 0) return;
+    if (workers.empty() || tasks == 1) {
+        for (int t = 0; t < tasks; ++t) fn(t, 0);
+        return;
+    }
+
+    {
+        lock_guard<std::mutex> lock(guard);
+        job = &fn;
+        jobTasks = tasks;
+        nextTask = 0;
+        busy = (int)workers.size();
+        generation++;
+    }
+    wake.notify_all();
+    drain(0);
+
+    unique_lock<std::mutex> lock(guard);
+    done.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
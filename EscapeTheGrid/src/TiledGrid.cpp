@@ -0,0 +1,243 @@
+#include "TiledGrid.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    const char MAGIC[4] = { 'E', 'T', 'G', 'T' };
+    const int VERSION = 1;
+
+    // magic, versión, TILE, W, H, startX, startY, goalX, goalY
+    const streamoff HEADER_SIZE = 4 + 8 * sizeof(int32_t);
+    const streamoff TILE_BYTES = TiledGrid::TILE * TiledGrid::TILE;
+
+    CellType parseCell(const string& t) {
+        if (t == "#") return CellType::Wall;
+        if (t == "S") return CellType::Start;
+        if (t == "G") return CellType::Goal;
+        if (t == "C" || t == "K") return CellType::Crystal;
+        return CellType::Empty;
+    }
+}
+
+bool TiledGrid::open(const string& path, size_t memoryBudget) {
+    close();
+    file.open(path, ios::in | ios::out | ios::binary);
+    if (!file.is_open()) {
+        cout << "No se pudo abrir: " << path << endl;
+        return false;
+    }
+
+    char magic[4];
+    int32_t header[8];
+    file.read(magic, 4);
+    file.read((char*)header, sizeof(header));
+    if (!file || !equal(magic, magic + 4, MAGIC) || header[0] != VERSION || header[1] != TILE) {
+        cout << "Archivo de bloques invalido: " << path << endl;
+        file.close();
+        return false;
+    }
+    W = header[2]; H = header[3];
+    sx = header[4]; sy = header[5];
+    gx = header[6]; gy = header[7];
+    tilesX = (W + TILE - 1) / TILE;
+    tilesY = (H + TILE - 1) / TILE;
+
+    // Un archivo cortado se rechaza acá y no al leer el bloque que falta
+    file.seekg(0, ios::end);
+    streamoff expected = HEADER_SIZE + (streamoff)tilesX * tilesY * TILE_BYTES;
+    if (W <= 0 || H <= 0 || !file || file.tellg() != expected) {
+        cout << "Archivo de bloques incompleto: " << path << endl;
+        file.close();
+        return false;
+    }
+
+    slotOf.assign((size_t)tilesX * tilesY, -1);
+    size_t capacity = max<size_t>(1, memoryBudget / TILE_BYTES);
+    slots.assign(min(capacity, slotOf.size()), Slot());
+    used = 0;
+    head = tail = -1;
+    lastTile = lastSlot = -1;
+    loads = 0;
+    ioFailed = false;
+    return true;
+}
+
+bool TiledGrid::close() {
+    if (!file.is_open()) return true;
+    bool ok = flush();
+    file.close();
+    slots.clear();
+    slotOf.clear();
+    return ok;
+}
+
+// Avisa la primera falla; las siguientes solo se cuentan en failed()
+void TiledGrid::report(const string& message) {
+    if (!ioFailed) cout << message << endl;
+    ioFailed = true;
+    file.clear();
+}
+
+bool TiledGrid::readTile(Slot& slot) {
+    file.seekg(HEADER_SIZE + slot.tile * TILE_BYTES);
+    file.read((char*)slot.cells.data(), TILE_BYTES);
+    if (file) return true;
+    fill(slot.cells.begin(), slot.cells.end(), uint8_t(CellType::Wall));
+    report("Error leyendo el bloque " + to_string(slot.tile));
+    return false;
+}
+
+bool TiledGrid::writeTile(const Slot& slot) {
+    file.seekp(HEADER_SIZE + slot.tile * TILE_BYTES);
+    file.write((const char*)slot.cells.data(), TILE_BYTES);
+    if (file) return true;
+    report("Error escribiendo el bloque " + to_string(slot.tile));
+    return false;
+}
+
+bool TiledGrid::flush() {
+    bool ok = true;
+    for (size_t s = 0; s < (size_t)used; ++s) {
+        if (slots[s].dirty) {
+            ok = writeTile(slots[s]) && ok;
+            slots[s].dirty = false;
+        }
+    }
+    file.flush();
+    if (!file) {
+        report("Error escribiendo el archivo de bloques");
+        ok = false;
+    }
+    return ok;
+}
+
+void TiledGrid::unlink(int s) {
+    Slot& slot = slots[s];
+    if (slot.prev >= 0) slots[slot.prev].next = slot.next; else head = slot.next;
+    if (slot.next >= 0) slots[slot.next].prev = slot.prev; else tail = slot.prev;
+    slot.prev = slot.next = -1;
+}
+
+void TiledGrid::pushFront(int s) {
+    slots[s].prev = -1;
+    slots[s].next = head;
+    if (head >= 0) slots[head].prev = s;
+    head = s;
+    if (tail < 0) tail = s;
+}
+
+// Slot con el bloque cargado; si el caché está lleno se desaloja el menos usado
+int TiledGrid::acquire(int tile) {
+    int s = slotOf[tile];
+    if (s >= 0) {
+        if (s != head) {
+            unlink(s);
+            pushFront(s);
+        }
+        return s;
+    }
+
+    if (used < (int)slots.size()) {
+        s = used++;
+        slots[s].cells.resize(TILE_BYTES);
+    } else {
+        s = tail;
+        unlink(s);
+        Slot& old = slots[s];
+        if (old.dirty) writeTile(old);
+        slotOf[old.tile] = -1;
+    }
+
+    Slot& slot = slots[s];
+    slot.tile = tile;
+    slot.dirty = false;
+    readTile(slot);
+    slotOf[tile] = s;
+    pushFront(s);
+    loads++;
+    return s;
+}
+
+uint8_t* TiledGrid::cell(int x, int y, bool write) {
+    int tile = (y / TILE) * tilesX + x / TILE;
+    // Los accesos suelen caer en el mismo bloque que el anterior
+    if (tile != lastTile) {
+        lastSlot = acquire(tile);
+        lastTile = tile;
+    }
+    Slot& slot = slots[lastSlot];
+    if (write) slot.dirty = true;
+    return &slot.cells[(y % TILE) * TILE + x % TILE];
+}
+
+CellType TiledGrid::type(int x, int y) {
+    return CellType(*cell(x, y, false));
+}
+
+void TiledGrid::setType(int x, int y, CellType t) {
+    *cell(x, y, true) = uint8_t(t);
+}
+
+bool TiledGrid::convert(const string& textPath, const string& tiledPath) {
+    ifstream in(textPath);
+    if (!in.is_open()) {
+        cout << "No se pudo abrir: " << textPath << endl;
+        return false;
+    }
+    int32_t w, h, startY, startX, goalY, goalX;
+    if (!(in >> w >> h >> startY >> startX >> goalY >> goalX)) {
+        cout << "Error leyendo dimensiones del laberinto" << endl;
+        return false;
+    }
+
+    ofstream out(tiledPath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        cout << "No se pudo crear: " << tiledPath << endl;
+        return false;
+    }
+    if (w <= 0 || h <= 0) {
+        cout << "Dimensiones invalidas del laberinto" << endl;
+        return false;
+    }
+    int32_t header[8] = { VERSION, TILE, w, h, startX, startY, goalX, goalY };
+    out.write(MAGIC, 4);
+    out.write((const char*)header, sizeof(header));
+
+    // Una franja de TILE filas por vez, ya separada en bloques
+    int tilesX = (w + TILE - 1) / TILE;
+    vector<uint8_t> band((size_t)tilesX * TILE_BYTES);
+    string line;
+    getline(in, line);
+    for (int y0 = 0; y0 < h; y0 += TILE) {
+        fill(band.begin(), band.end(), uint8_t(CellType::Wall));
+        for (int y = y0; y < min(h, y0 + TILE); ++y) {
+            if (!getline(in, line)) {
+                cout << "Error leyendo linea " << y << endl;
+                return false;
+            }
+            istringstream iss(line);
+            for (int x = 0; x < w; ++x) {
+                string t;
+                if (!(iss >> t)) {
+                    cout << "Error leyendo celda [" << x << "," << y << "]" << endl;
+                    return false;
+                }
+                band[(size_t)(x / TILE) * TILE_BYTES + (y - y0) * TILE + x % TILE] = uint8_t(parseCell(t));
+            }
+        }
+        if (!out.write((const char*)band.data(), band.size())) {
+            cout << "Error escribiendo: " << tiledPath << endl;
+            return false;
+        }
+    }
+    out.close();
+    if (!out) {
+        cout << "Error escribiendo: " << tiledPath << endl;
+        return false;
+    }
+    return true;
+}
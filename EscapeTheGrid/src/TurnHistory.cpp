@@ -0,0 +1,227 @@
+#include "TurnHistory.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+void TurnHistory::reset(CellGrid& grid, const TurnState& state) {
+    grid.setJournal(&journal);
+    journal.clear();
+    current = 0;
+    changes.clear();
+    ends.assign(1, 0);
+    states.assign(1, state);
+    checkpoints.clear();
+    addCheckpoint(grid);
+}
+
+void TurnHistory::commit(const CellGrid& grid, const TurnState& state) {
+    if (current < lastTurn()) {
+        changes.resize(ends[current]);
+        ends.resize(current + 1);
+        states.resize(current + 1);
+        while (!checkpoints.empty() && checkpoints.back().turn > current) checkpoints.pop_back();
+    }
+
+    // Una celda puede cambiar varias veces en el turno: vale el primer 'antes'
+    // y lo que tiene ahora; si volvió a su valor no queda nada
+    stable_sort(journal.begin(), journal.end(), [](const CellChange& a, const CellChange& b) {
+        return a.plane != b.plane ? a.plane < b.plane : a.cell < b.cell;
+    });
+    for (size_t k = 0; k < journal.size(); ++k) {
+        const CellChange& c = journal[k];
+        if (k > 0 && journal[k - 1].plane == c.plane && journal[k - 1].cell == c.cell) continue;
+        uint8_t after = c.plane == 0 ? uint8_t(grid.type(c.cell)) : grid.has(CellFlag(c.plane - 1), c.cell);
+        if (after != c.before) changes.push_back({c.cell, c.plane, c.before, after});
+    }
+    journal.clear();
+
+    ends.push_back((uint32_t)changes.size());
+    states.push_back(state);
+    current++;
+    if (current % CHECKPOINT_INTERVAL == 0) addCheckpoint(grid);
+}
+
+void TurnHistory::addCheckpoint(const CellGrid& grid) {
+    Checkpoint next;
+    next.turn = current;
+    int chunks = (grid.flagWords() + CHUNK_WORDS - 1) / CHUNK_WORDS;
+    vector<char> dirty;
+
+    if (checkpoints.empty()) {
+        next.types = GridSnapshot(grid);
+        dirty.assign(chunks, 1);
+        next.flags[0].resize(chunks);
+        next.flags[1].resize(chunks);
+    } else {
+        // Desde el punto anterior: solo se copia lo que tocaron los deltas
+        const Checkpoint& prev = checkpoints.back();
+        next.flags[0] = prev.flags[0];
+        next.flags[1] = prev.flags[1];
+        dirty.assign(chunks, 0);
+        vector<pair<int, CellType>> types;
+        for (uint32_t k = ends[prev.turn]; k < ends[current]; ++k) {
+            const Change& c = changes[k];
+            if (c.plane == 0) types.push_back({c.cell, grid.type(c.cell)});
+            else dirty[c.cell / (CHUNK_WORDS * 64)] = 1;
+        }
+        next.types = prev.types.withTypes(types);
+        for (const auto& t : types) next.typeCells.push_back(t.first);
+        sort(next.typeCells.begin(), next.typeCells.end());
+        next.typeCells.erase(unique(next.typeCells.begin(), next.typeCells.end()), next.typeCells.end());
+        for (int b = 0; b < chunks; ++b) {
+            if (dirty[b]) next.chunks.push_back(b);
+        }
+    }
+
+    for (int f = 0; f < 2; ++f) {
+        const uint64_t* plane = grid.flagData(f == 0 ? CellFlag::Traversed : CellFlag::Reflected);
+        for (int b = 0; b < chunks; ++b) {
+            if (!dirty[b]) continue;
+            auto chunk = make_shared<Chunk>();
+            chunk->fill(0);
+            int count = min(CHUNK_WORDS, grid.flagWords() - b * CHUNK_WORDS);
+            copy(plane + b * CHUNK_WORDS, plane + b * CHUNK_WORDS + count, chunk->begin());
+            next.flags[f][b] = move(chunk);
+        }
+    }
+    checkpoints.push_back(move(next));
+}
+
+int TurnHistory::checkpointBefore(int turn) const {
+    auto it = upper_bound(checkpoints.begin(), checkpoints.end(), turn,
+                          [](int t, const Checkpoint& c) { return t < c.turn; });
+    return int(it - checkpoints.begin()) - 1;
+}
+
+// Trabajo de restore(k) en escrituras de deltas: leer los deltas desde el
+// punto de control anterior al turno actual y reescribir lo que resumen los
+// puntos entre ese y el k. Medido, un tipo cuesta como dos escrituras y un
+// bloque (dos planos con sus bits distintos) como 8 por palabra
+long TurnHistory::restoreCost(int k) const {
+    int p = checkpointBefore(current);
+    long cost = (long)ends[current] - ends[checkpoints[p].turn];
+    for (int j = min(p, k) + 1; j <= max(p, k); ++j) {
+        cost += (long)checkpoints[j].typeCells.size() * 2 + (long)checkpoints[j].chunks.size() * CHUNK_WORDS * 8;
+    }
+    return cost;
+}
+
+void TurnHistory::restore(int k, CellGrid& grid) {
+    const Checkpoint& checkpoint = checkpoints[k];
+    int chunkCells = CHUNK_WORDS * 64;
+    dirtyChunk.resize((grid.flagWords() + CHUNK_WORDS - 1) / CHUNK_WORDS, 0);
+    auto markChunk = [&](int b) {
+        if (dirtyChunk[b]) return;
+        dirtyChunk[b] = 1;
+        restoreChunks.push_back(b);
+    };
+
+    // La grilla es el punto p más los deltas hasta el turno actual; lo único
+    // que puede diferir del punto k es lo que tocaron esos deltas y los
+    // puntos entre p y k
+    int p = checkpointBefore(current);
+    for (uint32_t c = ends[checkpoints[p].turn]; c < ends[current]; ++c) {
+        if (changes[c].plane == 0) restoreCells.push_back(changes[c].cell);
+        else markChunk(changes[c].cell / chunkCells);
+    }
+    for (int j = min(p, k) + 1; j <= max(p, k); ++j) {
+        restoreCells.insert(restoreCells.end(), checkpoints[j].typeCells.begin(), checkpoints[j].typeCells.end());
+        for (int b : checkpoints[j].chunks) markChunk(b);
+    }
+
+    int W = grid.width();
+    for (int cell : restoreCells) {
+        CellType t = checkpoint.types.type(cell % W, cell / W);
+        if (grid.type(cell) != t) grid.setType(cell, t);
+    }
+    // Bit por bit donde difieren, así la grilla anota solo esas celdas
+    for (int f = 0; f < 2; ++f) {
+        CellFlag flag = f == 0 ? CellFlag::Traversed : CellFlag::Reflected;
+        const uint64_t* plane = grid.flagData(flag);
+        for (int b : restoreChunks) {
+            const Chunk& saved = *checkpoint.flags[f][b];
+            int count = min(CHUNK_WORDS, grid.flagWords() - b * CHUNK_WORDS);
+            for (int w = 0; w < count; ++w) {
+                int word = b * CHUNK_WORDS + w;
+                for (uint64_t diff = plane[word] ^ saved[w]; diff; diff &= diff - 1) {
+                    int bit = __builtin_ctzll(diff);
+                    if ((saved[w] >> bit) & 1) grid.set(flag, word * 64 + bit);
+                    else grid.reset(flag, word * 64 + bit);
+                }
+            }
+        }
+    }
+
+    for (int b : restoreChunks) dirtyChunk[b] = 0;
+    restoreChunks.clear();
+    restoreCells.clear();
+    current = checkpoint.turn;
+}
+
+void TurnHistory::write(CellGrid& grid, int cell, int plane, uint8_t value) {
+    if (plane == 0) grid.setType(cell, CellType(value));
+    else if (value) grid.set(CellFlag(plane - 1), cell);
+    else grid.reset(CellFlag(plane - 1), cell);
+}
+
+// Cambios hechos después del último commit: se deshacen del último al primero
+void TurnHistory::revertPending(CellGrid& grid) {
+    for (size_t k = journal.size(); k-- > 0;) {
+        write(grid, journal[k].cell, journal[k].plane, journal[k].before);
+    }
+    journal.clear();
+}
+
+long TurnHistory::changeCount(int from, int to) const {
+    if (from > to) swap(from, to);
+    return (long)ends[to] - ends[from];
+}
+
+bool TurnHistory::jumpTo(int turn, CellGrid& grid, TurnState& state) {
+    if (turn < 0 || turn > lastTurn()) return false;
+
+    // Lo que se escribe acá no es un turno nuevo: va a 'restored'
+    restored.clear();
+    grid.setJournal(&restored);
+    revertPending(grid);
+
+    // Pasar por el punto de control anterior al turno pedido conviene si
+    // restaurarlo y aplicar los deltas desde ahí lee menos que ir directo
+    int k = checkpointBefore(turn);
+    long fromCheckpoint = restoreCost(k) + changeCount(checkpoints[k].turn, turn);
+    if (fromCheckpoint < changeCount(current, turn)) restore(k, grid);
+
+    for (; current < turn; ++current) {
+        for (uint32_t k = ends[current]; k < ends[current + 1]; ++k) {
+            write(grid, changes[k].cell, changes[k].plane, changes[k].after);
+        }
+    }
+    for (; current > turn; --current) {
+        for (uint32_t k = ends[current]; k-- > ends[current - 1];) {
+            write(grid, changes[k].cell, changes[k].plane, changes[k].before);
+        }
+    }
+
+    state = states[current];
+    grid.setJournal(&journal);
+    return true;
+}
+
+size_t TurnHistory::memoryBytes() const {
+    size_t bytes = changes.size() * sizeof(Change) + ends.size() * sizeof(uint32_t)
+                 + states.size() * sizeof(TurnState);
+    for (size_t k = 0; k < checkpoints.size(); ++k) {
+        const Checkpoint& c = checkpoints[k];
+        int tiles = ((c.types.width() + GridSnapshot::TILE - 1) / GridSnapshot::TILE)
+                  * ((c.types.height() + GridSnapshot::TILE - 1) / GridSnapshot::TILE);
+        int ownTiles = k == 0 ? tiles : tiles - c.types.sharedTiles(checkpoints[k - 1].types);
+        bytes += (size_t)ownTiles * GridSnapshot::TILE * GridSnapshot::TILE;
+        for (int f = 0; f < 2; ++f) {
+            for (size_t b = 0; b < c.flags[f].size(); ++b) {
+                if (k == 0 || c.flags[f][b] != checkpoints[k - 1].flags[f][b]) bytes += sizeof(Chunk);
+            }
+        }
+    }
+    return bytes;
+}
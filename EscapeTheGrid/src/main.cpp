@@ -1,28 +1,32 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
-#include <fstream>
-#include <sstream>
 #include <vector>
+#include <cstdio>
 #include <queue>
 #include <iostream>
 #include <cmath>
 #include <memory>
 
+#include "Grid.hpp"
+#include "AStar.hpp"
+#include "BFS.hpp"
+#include "CrystalReflector.hpp"
+#include "DistanceField.hpp"
+#include "FreeCellSet.hpp"
+#include "GridRenderer.hpp"
+#include "HierarchicalPlanner.hpp"
+#include "IncrementalPlanner.hpp"
+#include "JumpPointSearch.hpp"
+#include "MazeLoader.hpp"
+#include "ParallelBFS.hpp"
+#include "ThreadPool.hpp"
+#include "TurnHistory.hpp"
+
 using namespace std;
 
 // ==================== ESTRUCTURAS Y ENUMS ====================
-enum class CellType { Empty, Wall, Start, Goal, Crystal };
 enum class GameState { Menu, Playing, Solved };
 
-struct Cell { 
-    CellType type; 
-    bool visited = false; 
-    bool isOnPath = false;
-    bool hasBeenTraversed = false;
-    bool isReflected = false;
-};
-
-
 
 struct Button {
     sf::RectangleShape shape;
@@ -83,22 +87,39 @@ const int TURNS_PER_EVENT = 5;
 const int TURNS_TO_MOVE_GOAL = 10;
 int turnsSinceLastGoalMove = 0;
 int W, H;
-vector<Cell> grid;
+CellGrid grid;
 int startX, startY, goalX, goalY;
 vector<pair<int,int>> path;
 GameState gameState = GameState::Menu;
+IncrementalPlanner planner;
+BFSWorkspace bfsWorkspace;
+BidirectionalBFS bidirectionalBfs;
+AStarSolver aStar;
+JumpPointSearch jumpPointSearch;
+HierarchicalPlanner hierarchicalPlanner;
+SolverStrategy solverStrategy = SolverStrategy::BFS;
+DistanceField goalDistance;
+CrystalReflector crystalReflector;
+FreeCellSet freeCells;
+TurnHistory turnHistory;
+GridRenderer gridRenderer;
 
 float cellSize = 35.f;
 float menuWidth = 300.f;
 sf::Vector2f gameOffset(0, 0);
 sf::View gameView, menuView;
 
+// Cámara del tablero: con zoom 1 se ve el tablero entero
+const float MIN_VISIBLE_SIDE = 4.f;   // celdas en el lado más corto con el zoom máximo
+float cameraZoom = 1.f;
+sf::Vector2f cameraCenter;
+
 // ==================== FUNCIONES DEL JUEGO ====================
 
 void verifyGoal(sf::CircleShape& goal) {
     // Asegurar que la celda goal mantenga su tipo
-    if (grid[goalY*W + goalX].type != CellType::Goal) {
-        grid[goalY*W + goalX].type = CellType::Goal;
+    if (grid.type(goalY*W + goalX) != CellType::Goal) {
+        grid.setType(goalY*W + goalX, CellType::Goal);
     }
     
     // Mantener propiedades visuales con colores más vibrantes
@@ -115,26 +136,19 @@ void moveGoal(int currentX, int currentY, sf::CircleShape& goal) {
     int oldGoalX = goalX;
     int oldGoalY = goalY;
     
-    vector<pair<int, int>> emptyCells;
-    for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            if (grid[y*W + x].type == CellType::Empty && 
-                !(x == currentX && y == currentY)) {
-                emptyCells.emplace_back(y, x);
-            }
-        }
-    }
+    // Celda vacía al azar que no sea la del jugador
+    int target = freeCells.pick(currentY*W + currentX);
     
-    if (!emptyCells.empty()) {
-        int index = rand() % emptyCells.size();
-        auto [newY, newX] = emptyCells[index];
-        
-        grid[oldGoalY*W + oldGoalX].type = CellType::Empty;
-        goalX = newX;
-        goalY = newY;
-        grid[goalY*W + goalX].type = CellType::Goal;
+    if (target >= 0) {
+        grid.setType(oldGoalY*W + oldGoalX, CellType::Empty);
+        freeCells.insert(oldGoalY*W + oldGoalX);
+        goalX = target % W;
+        goalY = target / W;
+        grid.setType(target, CellType::Goal);
+        freeCells.erase(target);
         
         verifyGoal(goal);
+        goalDistance.markDirty();
         cout << "¡La salida se ha movido a (" << goalX << ", " << goalY << ")!\n";
     }
     
@@ -142,42 +156,15 @@ void moveGoal(int currentX, int currentY, sf::CircleShape& goal) {
 }
 
 bool loadMaze(const string& path) {
-    ifstream file(path);
-    if (!file.is_open()) {
-        cout << "No se pudo abrir: " << path << endl;
-        return false;
-    }
-    
-    if (!(file >> W >> H >> startY >> startX >> goalY >> goalX)) {
-        cout << "Error leyendo dimensiones del laberinto" << endl;
-        return false;
-    }
-    
-    grid.resize(W * H);
-    string line;
-    getline(file, line);
-    
-    for (int y = 0; y < H; y++) {
-        if (!getline(file, line)) {
-            cout << "Error leyendo linea " << y << endl;
-            return false;
-        }
-        istringstream iss(line);
-        for (int x = 0; x < W; x++) {
-            string t;
-            if (!(iss >> t)) {
-                cout << "Error leyendo celda [" << x << "," << y << "]" << endl;
-                return false;
-            }
-            if (t == "#") grid[y*W + x] = {CellType::Wall};
-            else if (t == "S") grid[y*W + x] = {CellType::Start};
-            else if (t == "G") grid[y*W + x] = {CellType::Goal};
-            else if (t == "C" || t == "K") grid[y*W + x] = {CellType::Crystal};
-            else grid[y*W + x] = {CellType::Empty};
-        }
-    }
-
-    return true;
+    MazeInfo maze;
+    bool ok = loadMazeFile(path, grid, maze);
+    W = maze.W;
+    H = maze.H;
+    startX = maze.startX;
+    startY = maze.startY;
+    goalX = maze.goalX;
+    goalY = maze.goalY;
+    return ok;
 }
 
 void createDefaultMaze() {
@@ -185,11 +172,7 @@ void createDefaultMaze() {
     startX = 1; startY = 1;
     goalX = 10; goalY = 8;
     
-    grid.resize(W * H);
-
-    for (auto& cell : grid) {
-        cell = {CellType::Empty};
-    }
+    grid.resize(W, H);
 
     vector<pair<int,int>> walls = {
         {0,0},{0,1},{0,2},{0,3},{0,4},{0,5},{0,6},{0,7},{0,8},{0,9},
@@ -202,14 +185,31 @@ void createDefaultMaze() {
     };
 
     for (auto [x,y] : walls) {
-        grid[y*W + x] = {CellType::Wall};
+        grid.setType(y*W + x, CellType::Wall);
     }
 
-    grid[3*W + 6] = {CellType::Crystal};
-    grid[6*W + 9] = {CellType::Crystal};
+    grid.setType(3*W + 6, CellType::Crystal);
+    grid.setType(6*W + 9, CellType::Crystal);
+
+    grid.setType(startY*W + startX, CellType::Start);
+    grid.setType(goalY*W + goalX, CellType::Goal);
+}
+
+void clampCamera() {
+    float closest = min(1.f, MIN_VISIBLE_SIDE / min(W, H));
+    cameraZoom = max(closest, min(1.f, cameraZoom));
+
+    // Sin salirse del tablero
+    float halfW = W * cellSize * cameraZoom / 2.f, halfH = H * cellSize * cameraZoom / 2.f;
+    cameraCenter.x = max(halfW, min(W * cellSize - halfW, cameraCenter.x));
+    cameraCenter.y = max(halfH, min(H * cellSize - halfH, cameraCenter.y));
+}
 
-    grid[startY*W + startX] = {CellType::Start};
-    grid[goalY*W + goalX] = {CellType::Goal};
+// Vuelve a mostrar el tablero entero
+void resetCamera(int x, int y) {
+    cameraZoom = 1.f;
+    cameraCenter = sf::Vector2f((x + 0.5f) * cellSize, (y + 0.5f) * cellSize);
+    clampCamera();
 }
 
 void resetGame(sf::CircleShape& goal) {
@@ -221,18 +221,29 @@ void resetGame(sf::CircleShape& goal) {
     // Variables para resolver el problema del botón JUGAR
     bool wasPlaying = (gameState == GameState::Playing);
 
+    // La carga del mapa no es parte de ningún turno
+    grid.setJournal(nullptr);
+
     if (!loadMaze("../assets/maze.txt") && !loadMaze("assets/maze.txt") && !loadMaze("maze.txt")) {
         createDefaultMaze();
     }
-
-    for (auto& cell : grid) {
-        cell.visited = false;
-        cell.isOnPath = false;
-        cell.hasBeenTraversed = false;
-        cell.isReflected = false;
-    }
-    
-    grid[startY*W + startX].hasBeenTraversed = true;
+    planner.invalidate();
+    hierarchicalPlanner.invalidate();
+    crystalReflector.reset();
+    freeCells.rebuild(grid);
+    goalDistance.markDirty();
+    gridRenderer.build(grid, cellSize);
+    resetCamera(startX, startY);
+
+    grid.clear(CellFlag::Visited);
+    grid.clear(CellFlag::OnPath);
+    grid.clear(CellFlag::Traversed);
+    grid.clear(CellFlag::Reflected);
+    
+    // El inicio ya refleja en el turno 0, así el historial nunca guarda un
+    // turno con reflejos pendientes fuera de los del evento
+    crystalReflector.traverse(grid, startX, startY);
+    turnHistory.reset(grid, {startX, startY, goalX, goalY, 0, 0});
     
     // Mantener el estado de juego si estaba jugando
     if (wasPlaying) {
@@ -242,22 +253,36 @@ void resetGame(sf::CircleShape& goal) {
     verifyGoal(goal);
 }
 
-bool inside(int y, int x) {
-    return x >= 0 && x < W && y >= 0 && y < H;
-}
-
-void triggerMapEvent() {
+// Devuelve la celda que cambió entre muro y vacío, o -1 si no cambió nada
+int triggerMapEvent() {
     int rx = rand() % W;
     int ry = rand() % H;
-    Cell& c = grid[ry*W + rx];
-    if (c.type == CellType::Empty) {
-        c.type = CellType::Wall;
+    int c = ry*W + rx;
+    if (grid.type(c) == CellType::Empty) {
+        grid.setType(c, CellType::Wall);
+        freeCells.erase(c);
         cout << "Evento: aparece muro en (" << rx << "," << ry << ")\n";
     }
-    else if (c.type == CellType::Wall) {
-        c.type = CellType::Empty;
+    else if (grid.type(c) == CellType::Wall) {
+        grid.setType(c, CellType::Empty);
+        freeCells.insert(c);
         cout << "Evento: desaparece muro en (" << rx << "," << ry << ")\n";
     }
+    else {
+        return -1;
+    }
+    planner.cellChanged(rx, ry);
+    hierarchicalPlanner.cellChanged(rx, ry);
+    crystalReflector.cellChanged(rx, ry);
+    goalDistance.markDirty();
+    return c;
+}
+
+// Los hilos del BFS paralelo se crean la primera vez que se usa, no al abrir el juego
+ParallelBFS& parallelBfs() {
+    static ThreadPool pool;
+    static ParallelBFS bfs(pool);
+    return bfs;
 }
 
 void bfsSolve() {
@@ -266,94 +291,110 @@ void bfsSolve() {
     int tempGoalY = goalY;
     
     // Restablecer propiedades de las celdas, excepto la meta
-    for (auto& cell : grid) {
-        cell.visited = false;
-        cell.isOnPath = false;
-    }
+    grid.clear(CellFlag::Visited);
+    grid.clear(CellFlag::OnPath);
     
     // Restaurar la meta en su posición original
-    grid[tempGoalY*W + tempGoalX].type = CellType::Goal;
+    grid.setType(tempGoalY*W + tempGoalX, CellType::Goal);
     goalX = tempGoalX;
     goalY = tempGoalY;
     
-    path.clear();
-    
-    vector<vector<bool>> vis(H, vector<bool>(W, false));
-    vector<vector<pair<int,int>>> parent(H, vector<pair<int,int>>(W, {-1,-1}));
-    queue<pair<int,int>> q;
-    q.push({startY, startX});
-    vis[startY][startX] = true;
-    
-    int dirs[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
     bool found = false;
+    switch (solverStrategy) {
+        case SolverStrategy::Bidirectional:
+            found = bidirectionalBfs.solve(grid, W, H, startX, startY, goalX, goalY, path);
+            break;
+        case SolverStrategy::AStar:
+            found = aStar.solve(grid, W, H, startX, startY, goalX, goalY, path);
+            break;
+        case SolverStrategy::JumpPoint:
+            found = jumpPointSearch.solve(grid, W, H, startX, startY, goalX, goalY, path);
+            break;
+        case SolverStrategy::Hierarchical:
+            found = hierarchicalPlanner.solve(grid, W, H, startX, startY, goalX, goalY, path);
+            break;
+        case SolverStrategy::Parallel:
+            found = parallelBfs().solve(grid, W, H, startX, startY, goalX, goalY, path);
+            break;
+        case SolverStrategy::BFS:
+        default:
+            found = bfsWorkspace.solve(grid, W, H, startX, startY, goalX, goalY, path);
+            for (int k = 0; k < bfsWorkspace.lastStats().expanded; ++k) {
+                grid.set(CellFlag::Visited, bfsWorkspace.expandedCells()[k]);
+            }
+            break;
+    }
 
-    while (!q.empty()) {
-        auto [y,x] = q.front(); q.pop();
-        grid[y*W+x].visited = true;
-        
-        if (y == goalY && x == goalX) { 
-            found = true; 
-            break; 
-        }
-        
-        for (auto& d : dirs) {
-            int ny = y + d[0];
-            int nx = x + d[1];
-            
-            if (!inside(ny,nx)) continue;
-            if (grid[ny*W+nx].type == CellType::Wall || vis[ny][nx]) continue;
-            
-            vis[ny][nx] = true;
-            parent[ny][nx] = {y,x};
-            q.push({ny,nx});
+    if (found) {
+        for (auto [y, x] : path) {
+            grid.set(CellFlag::OnPath, y*W + x);
         }
     }
+}
 
-    if (found) {
-        for (int cy = goalY, cx = goalX; cy != -1; ) {
-            path.push_back({cy,cx});
-            grid[cy*W+cx].isOnPath = true;
-            auto p = parent[cy][cx];
-            cy = p.first; 
-            cx = p.second;
+// Replanificación del modo automático: reutiliza el estado del planificador
+// y solo repara lo que cambió desde la última llamada
+void incrementalSolve() {
+    grid.clear(CellFlag::Visited);
+    grid.clear(CellFlag::OnPath);
+
+    if (planner.replan(grid, W, H, startX, startY, goalX, goalY, path)) {
+        for (auto [y, x] : path) {
+            grid.set(CellFlag::OnPath, y*W + x);
         }
-        reverse(path.begin(), path.end());
     }
 }
 
-void reflectCrystals() {
-    for (auto& c : grid) {
-        c.isReflected = false;
+// Pista: siguiente paso óptimo desde la posición actual, sin lanzar una búsqueda
+void showHint(int currentX, int currentY) {
+    goalDistance.update(grid, W, H, goalX, goalY);
+
+    int nextX, nextY;
+    if (goalDistance.nextStep(grid, currentX, currentY, nextX, nextY)) {
+        cout << "Pista: mover a (" << nextX << ", " << nextY << "), faltan "
+             << goalDistance.distance(currentX, currentY) << " pasos\n";
+    } else {
+        cout << "Pista: no hay camino hasta la meta\n";
     }
+}
 
-    for (int y = 0; y < H; ++y) {
-        for (int x = 0; x < W; ++x) {
-            if (grid[y*W + x].type != CellType::Crystal) 
-                continue;
-
-            for (int d = 1; ; ++d) {
-                int xs = x - d, xt = x + d;
-                if (xs < 0 || xt >= W) break;
-                if (grid[y*W + xs].hasBeenTraversed && grid[y*W + xt].type != CellType::Wall) {
-                    grid[y*W + xt].hasBeenTraversed = true;
-                    grid[y*W + xt].isReflected = true;
-                }
-            }
+void recordTurn(int x, int y, int eventCell) {
+    turnHistory.commit(grid, {x, y, goalX, goalY, turnCount, turnsSinceLastGoalMove, eventCell});
+}
 
-            for (int d = 1; ; ++d) {
-                int ys = y - d, yt = y + d;
-                if (ys < 0 || yt >= H) break;
-                if (grid[ys*W + x].hasBeenTraversed && grid[yt*W + x].type != CellType::Wall) {
-                    grid[yt*W + x].hasBeenTraversed = true;
-                    grid[yt*W + x].isReflected = true;
-                }
-            }
+// Vuelve al estado de un turno del historial. Las celdas que reescribió el
+// historial pasan por los mismos índices que un movimiento normal, sin
+// recorrer el tablero
+void restoreTurn(const TurnState& state, sf::CircleShape& goal) {
+    goalX = state.goalX;
+    goalY = state.goalY;
+    turnCount = state.turnCount;
+    turnsSinceLastGoalMove = state.turnsSinceLastGoalMove;
+    path.clear();
+    grid.clear(CellFlag::Visited);
+    grid.clear(CellFlag::OnPath);
+
+    const vector<CellChange>& changes = turnHistory.lastRestored();
+    for (const CellChange& c : changes) {
+        if (c.plane != 0) continue;
+        if (grid.type(c.cell) == CellType::Empty) freeCells.insert(c.cell);
+        else freeCells.erase(c.cell);
+        // Como en triggerMapEvent(): los planificadores solo miran los muros
+        if ((CellType(c.before) == CellType::Wall) != grid.isWall(c.cell)) {
+            planner.cellChanged(c.cell % W, c.cell / W);
+            hierarchicalPlanner.cellChanged(c.cell % W, c.cell / W);
         }
     }
+    crystalReflector.turnRestored(grid, changes);
+    if (state.eventCell >= 0) {
+        crystalReflector.cellChanged(state.eventCell % W, state.eventCell / W);
+    }
+    goalDistance.markDirty();
+    verifyGoal(goal);
 }
 
 bool tryMovePlayer(int newX, int newY, int& currentX, int& currentY, sf::CircleShape& player, sf::CircleShape& goal) {
-    if (inside(newY, newX) && grid[newY*W + newX].type != CellType::Wall) {
+    if (grid.passable(newX, newY)) {
         currentX = newX;
         currentY = newY;
         sf::Vector2f newPos(
@@ -362,8 +403,7 @@ bool tryMovePlayer(int newX, int newY, int& currentX, int& currentY, sf::CircleS
         );
         player.setPosition(newPos);
 
-        grid[currentY*W + currentX].hasBeenTraversed = true;
-        reflectCrystals();
+        crystalReflector.traverse(grid, currentX, currentY);
 
         turnCount++;
         turnsSinceLastGoalMove++;
@@ -372,70 +412,17 @@ bool tryMovePlayer(int newX, int newY, int& currentX, int& currentY, sf::CircleS
             moveGoal(currentX, currentY, goal);
         }
         
+        int eventCell = -1;
         if (turnCount % TURNS_PER_EVENT == 0) {
-            triggerMapEvent();
+            eventCell = triggerMapEvent();
         }
 
+        recordTurn(currentX, currentY, eventCell);
         return true;
     }
     return false;
 }
 
-sf::ConvexShape makeTri(int x, int y) {
-    sf::ConvexShape tri;
-    tri.setPointCount(3);
-    
-    const float verticalGap = 8.f;
-    const float horizontalGap = 3.f;
-    bool up = (x + y) % 2 == 0;
-
-    float px = x * cellSize + horizontalGap/2;
-    float py = y * cellSize + verticalGap/2;
-    float triWidth = cellSize - horizontalGap;
-    float triHeight = cellSize - verticalGap;
-    
-    const float horizontalStretch = 10.f;
-    const float verticalStretch = 0.f;
-    
-    float left = px - horizontalStretch/2;
-    float right = px + triWidth + horizontalStretch/2;
-    float centerX = px + triWidth / 2.f;
-    
-    float top = py;
-    float bottom = py + triHeight + verticalStretch;
-
-    if (up) {
-        tri.setPoint(0, sf::Vector2f(centerX, top));
-        tri.setPoint(1, sf::Vector2f(left, bottom));
-        tri.setPoint(2, sf::Vector2f(right, bottom));
-    } else {
-        tri.setPoint(0, sf::Vector2f(centerX, bottom));
-        tri.setPoint(1, sf::Vector2f(left, top));
-        tri.setPoint(2, sf::Vector2f(right, top));
-    }
-
-    tri.setOutlineThickness(0.5f);
-    tri.setOutlineColor(sf::Color(100, 100, 100, 100));
-    return tri;
-}
-
-sf::Color getCellColor(CellType type, int x, int y, bool visited, bool isOnPath, bool hasBeenTraversed, bool isReflected) {
-    // IMPORTANTE: La meta (Goal) siempre debe ser verde, sin importar otros estados
-    if (type == CellType::Goal) return sf::Color(0, 200, 0, 150); // Verde para la celda de meta
-    
-    if (type == CellType::Crystal) return sf::Color(0, 255, 255, 180);
-    if (isReflected) return sf::Color(150, 220, 255, 200);
-    if (hasBeenTraversed) return sf::Color(192, 192, 192, 200);
-    if (visited) return sf::Color(150, 150, 255, 150);
-
-    switch (type) {
-        case CellType::Wall: return sf::Color(40, 40, 40);
-        case CellType::Start: return sf::Color(100, 255, 100, 200);
-        case CellType::Empty:
-        default: return ((x + y) % 2 == 0) ? sf::Color(120, 120, 200, 120) : sf::Color(100, 100, 180, 120);
-    }
-}
-
 sf::Text createStyledText(const string& text, sf::Font& font, int size, sf::Color color, float x, float y) {
     sf::Text styledText(text, font, size);
     styledText.setFillColor(color);
@@ -458,25 +445,46 @@ void updateViews(sf::RenderWindow& window) {
     float gameHeight = H * cellSize;
     
     float gameViewWidth = windowSize.x - menuWidth;
-    gameView.reset(sf::FloatRect(0, 0, gameWidth, gameHeight));
+    gameView.setSize(gameWidth * cameraZoom, gameHeight * cameraZoom);
+    gameView.setCenter(cameraCenter);
     gameView.setViewport(sf::FloatRect(0, 0, gameViewWidth / windowSize.x, 1.0f));
     
     menuView.reset(sf::FloatRect(0, 0, menuWidth, windowSize.y));
     menuView.setViewport(sf::FloatRect(gameViewWidth / windowSize.x, 0, menuWidth / windowSize.x, 1.0f));
 }
 
+// Zoom manteniendo bajo el cursor el mismo punto del tablero
+void zoomCamera(sf::RenderWindow& window, float factor, sf::Vector2i mousePos) {
+    sf::Vector2f before = windowToGameCoords(mousePos, window);
+    cameraZoom *= factor;
+    clampCamera();
+    updateViews(window);
+    cameraCenter += before - windowToGameCoords(mousePos, window);
+    clampCamera();
+    updateViews(window);
+}
+
+void panCamera(sf::RenderWindow& window, sf::Vector2i from, sf::Vector2i to) {
+    cameraCenter += windowToGameCoords(from, window) - windowToGameCoords(to, window);
+    clampCamera();
+    updateViews(window);
+}
+
 int main() {
     if (!loadMaze("../assets/maze.txt") && !loadMaze("assets/maze.txt") && !loadMaze("maze.txt")) {
         
         createDefaultMaze();
     }
 
-    float initialGameWidth = W * cellSize;
-    float initialGameHeight = H * cellSize;
+    // Sin pasarse del escritorio en mapas grandes; el resto se ve con la cámara
+    sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+    float initialGameWidth = min(W * cellSize, desktop.width * 0.9f - menuWidth);
+    float initialGameHeight = min(H * cellSize, desktop.height * 0.9f);
     float initialTotalWidth = initialGameWidth + menuWidth;
     
     sf::RenderWindow window(sf::VideoMode(initialTotalWidth, initialGameHeight), "Escape the Grid");
     window.setFramerateLimit(60);
+    resetCamera(startX, startY);
     
     updateViews(window);
     
@@ -503,22 +511,29 @@ int main() {
     buttons.push_back(make_unique<Button>(30, 150, 240, 40, "AUTOCOMPLETAR", font, sf::Color(150, 100, 50, 200)));
     buttons.push_back(make_unique<Button>(30, 200, 240, 40, "REINICIAR", font, sf::Color(150, 50, 50, 200)));
 
-    float column1X = 30, column2X = 160, columnsStartY = 260;
+    // Dos columnas de 140 px bajo los botones. Todo tiene que terminar antes
+    // del estado en windowSize.y - 60, que con el laberinto de 15x15 es y = 465
+    float column1X = 20, column2X = 160, columnsStartY = 250;
     sf::Text infoTitle = createStyledText("INFORMACION", font, 16, sf::Color(255, 255, 150), column1X, columnsStartY);
     vector<sf::Text> infoTexts = {
-        createStyledText("- Jugador (azul)", font, 14, sf::Color(100, 150, 255), column1X, columnsStartY + 30),
-        createStyledText("- Meta (verde)", font, 14, sf::Color(100, 255, 100), column1X, columnsStartY + 60),
-        createStyledText("- Muro (gris)", font, 14, sf::Color(150, 150, 150), column1X, columnsStartY + 90),
-        createStyledText("- Cristal (cyan)", font, 14, sf::Color(0, 255, 255), column1X, columnsStartY + 120)
+        createStyledText("- Jugador (azul)", font, 13, sf::Color(100, 150, 255), column1X, columnsStartY + 24),
+        createStyledText("- Meta (verde)", font, 13, sf::Color(100, 255, 100), column2X, columnsStartY + 24),
+        createStyledText("- Muro (gris)", font, 13, sf::Color(150, 150, 150), column1X, columnsStartY + 43),
+        createStyledText("- Cristal (cyan)", font, 13, sf::Color(0, 255, 255), column2X, columnsStartY + 43)
     };
 
-    sf::Text controlsTitle = createStyledText("CONTROLES", font, 16, sf::Color(255, 255, 150), column2X, columnsStartY);
-    vector<sf::Text> controlTexts = {
-        createStyledText("- Flechas: Mover", font, 14, sf::Color(200, 200, 200), column2X, columnsStartY + 30),
-        createStyledText("- ENTER: Resolver", font, 14, sf::Color(200, 200, 200), column2X, columnsStartY + 60),
-        createStyledText("- R: Reiniciar", font, 14, sf::Color(200, 200, 200), column2X, columnsStartY + 90),
-        createStyledText("- Click: Mover", font, 14, sf::Color(200, 200, 200), column2X, columnsStartY + 120)
+    // Seis filas por columna, de arriba abajo y después la segunda columna
+    float controlsStartY = columnsStartY + 72;
+    sf::Text controlsTitle = createStyledText("CONTROLES", font, 16, sf::Color(255, 255, 150), column1X, controlsStartY);
+    const vector<string> controls = {
+        "- Flechas: Mover", "- Click: Mover", "- ENTER: Resolver", "- R: Reiniciar", "- E: Estrategia", "- H: Pista",
+        "- Z/Y: Deshacer", "- Rueda: Zoom", "- Click der.: Vista", "- V: Shader", "- F: Tiempo cuadro"
     };
+    vector<sf::Text> controlTexts;
+    for (size_t k = 0; k < controls.size(); ++k) {
+        controlTexts.push_back(createStyledText(controls[k], font, 13, sf::Color(200, 200, 200),
+                                                k < 6 ? column1X : column2X, controlsStartY + 24 + 19 * (k % 6)));
+    }
 
     sf::Text statusText("", font, 14);
     sf::Text movesText("Movimientos: 0", font, 14);
@@ -542,8 +557,24 @@ int main() {
     sf::Clock gameClock, moveClock;
     int currentX = startX, currentY = startY;
     int moveCount = 0;
-    
-    grid[startY*W + startX].hasBeenTraversed = true;
+    bool dragging = false;
+    sf::Vector2i dragFrom;
+
+    // F: tiempo por cuadro arriba a la izquierda, sin el tope de 60 fps. La
+    // segunda vez fuerza triángulos para compararlos con GridLod
+    int frameTimeMode = 0;
+    int framesMeasured = 0;
+    sf::Clock frameReport;
+    sf::Text frameText("", font, 14);
+    frameText.setFillColor(sf::Color(255, 255, 150));
+    frameText.setOutlineColor(sf::Color::Black);
+    frameText.setOutlineThickness(1.f);
+    frameText.setPosition(8, 8);
+    
+    freeCells.rebuild(grid);
+    gridRenderer.build(grid, cellSize);
+    crystalReflector.traverse(grid, startX, startY);
+    turnHistory.reset(grid, {startX, startY, goalX, goalY, 0, 0});
 
     while (window.isOpen()) {
         float dt = moveClock.restart().asSeconds();
@@ -561,6 +592,11 @@ int main() {
                 sf::Vector2i mousePos(e.mouseButton.x, e.mouseButton.y);
                 sf::Vector2f menuCoords = windowToMenuCoords(mousePos, window);
                 sf::Vector2f gameCoords = windowToGameCoords(mousePos, window);
+
+                if (e.mouseButton.button == sf::Mouse::Right && mousePos.x < (int)window.getSize().x - menuWidth) {
+                    dragging = true;
+                    dragFrom = mousePos;
+                }
                 
                 bool buttonClicked = false;
                 for (size_t i = 0; i < buttons.size(); i++) {
@@ -629,9 +665,24 @@ int main() {
                 }
             }
             
+            if (e.type == sf::Event::MouseWheelScrolled && e.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel &&
+                e.mouseWheelScroll.x < (int)window.getSize().x - menuWidth) {
+                zoomCamera(window, e.mouseWheelScroll.delta > 0 ? 0.8f : 1.25f,
+                           sf::Vector2i(e.mouseWheelScroll.x, e.mouseWheelScroll.y));
+            }
+
+            if (e.type == sf::Event::MouseButtonReleased && e.mouseButton.button == sf::Mouse::Right) {
+                dragging = false;
+            }
+
             if (e.type == sf::Event::MouseMoved) {
                 sf::Vector2i mousePos(e.mouseMove.x, e.mouseMove.y);
                 sf::Vector2f menuCoords = windowToMenuCoords(mousePos, window);
+
+                if (dragging) {
+                    panCamera(window, dragFrom, mousePos);
+                    dragFrom = mousePos;
+                }
                 
                 for (auto& button : buttons) {
                     button->updateHover(menuCoords.x, menuCoords.y);
@@ -673,6 +724,51 @@ int main() {
                     currentPos = player.getPosition();
                 }
                 
+                if (e.key.code == sf::Keyboard::H && !autoMode && !solved && gameState == GameState::Playing) {
+                    showHint(currentX, currentY);
+                }
+                
+                if ((e.key.code == sf::Keyboard::Z || e.key.code == sf::Keyboard::Y) &&
+                    !autoMode && gameState != GameState::Menu) {
+                    TurnState state;
+                    bool changed = e.key.code == sf::Keyboard::Z ? turnHistory.undo(grid, state)
+                                                                 : turnHistory.redo(grid, state);
+                    if (changed) {
+                        restoreTurn(state, goal);
+                        currentX = state.playerX;
+                        currentY = state.playerY;
+                        player.setPosition(
+                            currentX * cellSize + cellSize/2 - cellSize/5,
+                            currentY * cellSize + cellSize/2 - cellSize/5
+                        );
+                        currentPos = player.getPosition();
+                        moveCount = state.turnCount;
+                        solved = currentX == goalX && currentY == goalY;
+                        gameState = solved ? GameState::Solved : GameState::Playing;
+                    }
+                }
+
+                if (e.key.code == sf::Keyboard::V) {
+                    bool on = !gridRenderer.usingShader();
+                    if (gridRenderer.useShader(grid, on)) {
+                        cout << (on ? "Dibujo con shader\n" : "Dibujo con triangulos\n");
+                    }
+                }
+
+                if (e.key.code == sf::Keyboard::F) {
+                    frameTimeMode = (frameTimeMode + 1) % 3;
+                    window.setFramerateLimit(frameTimeMode ? 0 : 60);
+                    gridRenderer.allowLod(frameTimeMode != 2);
+                    framesMeasured = 0;
+                    frameReport.restart();
+                    frameText.setString(frameTimeMode ? "Midiendo..." : "");
+                }
+
+                if (e.key.code == sf::Keyboard::E) {
+                    solverStrategy = nextStrategy(solverStrategy);
+                    cout << "Estrategia: " << strategyName(solverStrategy) << "\n";
+                }
+                
                 if (e.key.code == sf::Keyboard::R) {
                     resetGame(goal);
                     currentX = startX;
@@ -712,8 +808,7 @@ int main() {
                 currentX = x;
                 currentY = y;
 
-                grid[y*W + x].hasBeenTraversed = true;
-                reflectCrystals();
+                crystalReflector.traverse(grid, x, y);
 
                 turnCount++;
                 turnsSinceLastGoalMove++;
@@ -723,7 +818,7 @@ int main() {
                 }
                 
                 if (turnCount % TURNS_PER_EVENT == 0) {
-                    triggerMapEvent();
+                    int eventCell = triggerMapEvent();
                     startY = currentY;
                     startX = currentX;
 
@@ -731,13 +826,14 @@ int main() {
                     int savedGoalX = goalX;
                     int savedGoalY = goalY;
 
-                    bfsSolve();
+                    incrementalSolve();
 
                     // Restaurar la meta después del cálculo
                     goalX = savedGoalX;
                     goalY = savedGoalY;
-                    grid[goalY*W + goalX].type = CellType::Goal;
+                    grid.setType(goalY*W + goalX, CellType::Goal);
                     verifyGoal(goal);
+                    recordTurn(currentX, currentY, eventCell);
 
                     step = 0;
                     if (path.empty()) {
@@ -747,6 +843,7 @@ int main() {
                     continue;  
                 }
 
+                recordTurn(currentX, currentY, -1);
                 step++;
                 moveCount++;
 
@@ -800,22 +897,11 @@ int main() {
 
         window.clear(sf::Color(15, 15, 25));
         
+        updateViews(window);
         window.setView(gameView);
 
-        for (int y = 0; y < H; ++y) {
-            for (int x = 0; x < W; ++x) {
-                Cell& cell = grid[y*W + x];
-                sf::ConvexShape tri = makeTri(x, y);
-                tri.setFillColor(getCellColor(cell.type, x, y, cell.visited, cell.isOnPath, cell.hasBeenTraversed, cell.isReflected));
-                window.draw(tri);
-                
-                if (cell.type == CellType::Crystal) {
-                    sf::ConvexShape crystalTri = makeTri(x, y);
-                    crystalTri.setFillColor(sf::Color(255, 255, 255, 50));
-                    window.draw(crystalTri);
-                }
-            }
-        }
+        gridRenderer.update(grid, window);
+        gridRenderer.draw(window);
 
         // Dibujar meta (goal) y jugador en orden correcto
         verifyGoal(goal);  // Asegurar que está correcto antes de dibujar
@@ -845,7 +931,24 @@ int main() {
         window.draw(statusText);
         window.draw(movesText);
         window.draw(timeText);
-        
+
+        // Promedio de cada medio segundo, con lo que se usó para dibujar el tablero
+        if (frameTimeMode) {
+            framesMeasured++;
+            float seconds = frameReport.getElapsedTime().asSeconds();
+            if (seconds >= 0.5f) {
+                const char* mode = gridRenderer.usingShader() ? "shader" : gridRenderer.usingLod() ? "LOD" : "triangulos";
+                char line[80];
+                snprintf(line, sizeof(line), "%.2f ms/cuadro (%.0f fps) - %s%s", seconds * 1000 / framesMeasured,
+                         framesMeasured / seconds, mode, frameTimeMode == 2 ? " [sin LOD]" : "");
+                frameText.setString(line);
+                framesMeasured = 0;
+                frameReport.restart();
+            }
+            window.setView(sf::View(sf::FloatRect(0, 0, windowSize.x, windowSize.y)));
+            window.draw(frameText);
+        }
+
         window.display();
     }
 
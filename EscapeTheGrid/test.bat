@@ -0,0 +1,38 @@
+@echo off
+cd /d "%~dp0"
+
+REM Pruebas de tests\ (sin SFML). Cada una devuelve 1 si algo no coincide
+if not exist build mkdir build
+
+echo =============================
+echo Compilando y corriendo tests\
+echo =============================
+
+call :TEST MirrorKernelTest "src\CrystalReflector.cpp src\Grid.cpp src\MirrorKernel.cpp" ""
+if errorlevel 1 goto :FAIL
+call :TEST MirrorKernelTest "src\CrystalReflector.cpp src\Grid.cpp src\MirrorKernel.cpp" "-DETG_NO_AVX2"
+if errorlevel 1 goto :FAIL
+call :TEST PathQueriesTest "src\BFS.cpp src\Grid.cpp src\GridSnapshot.cpp src\PathQueries.cpp src\ThreadPool.cpp" ""
+if errorlevel 1 goto :FAIL
+call :TEST TiledGridTest "src\Grid.cpp src\MazeLoader.cpp src\TiledGrid.cpp" ""
+if errorlevel 1 goto :FAIL
+call :TEST TurnHistoryTest "src\CrystalReflector.cpp src\FreeCellSet.cpp src\Grid.cpp src\GridSnapshot.cpp src\MirrorKernel.cpp src\TurnHistory.cpp" ""
+if errorlevel 1 goto :FAIL
+
+echo Pruebas completadas.
+pause
+goto :EOF
+
+:TEST
+echo.
+echo ---- %1 %~3 ----
+g++ -O2 -std=c++17 %~3 -I include tests\%1.cpp %~2 -o build\%1.exe
+if errorlevel 1 exit /b 1
+build\%1.exe
+if errorlevel 1 exit /b 1
+exit /b 0
+
+:FAIL
+echo Una prueba fallo.
+pause
+exit /b 1
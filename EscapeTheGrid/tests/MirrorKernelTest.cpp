@@ -0,0 +1,176 @@
+// Prueba de los reflejos de cristales contra la pasada escalar original
+// (reflectCrystals() de main.cpp antes de CrystalReflector):
+//  - MirrorKernel sobre tableros al azar, celda por celda en Traversed,
+//    Reflected y el plano de espejadas;
+//  - CrystalReflector paso a paso, con muros que aparecen y desaparecen entre
+//    pasos como en triggerMapEvent(), contra la pasada completa tras cada paso.
+// Los anchos caen a ambos lados de los múltiplos de 64 para probar los bordes
+// de palabra. Devuelve 1 y muestra la primera diferencia si algo no coincide.
+//
+// Se arma con test.bat (o a mano: g++ -O2 -std=c++17 -I include
+// tests/MirrorKernelTest.cpp src/CrystalReflector.cpp src/Grid.cpp
+// src/MirrorKernel.cpp). test.bat la corre dos veces, la segunda con
+// -DETG_NO_AVX2 para cubrir también el camino escalar de MirrorKernel.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "CrystalReflector.hpp"
+#include "Grid.hpp"
+#include "MirrorKernel.hpp"
+
+using namespace std;
+
+// reflectCrystals() como era, más el plano de espejadas que arma MirrorKernel
+static void reflectCrystals(CellGrid& grid, vector<uint64_t>& mirrored) {
+    int W = grid.width(), H = grid.height();
+    grid.clear(CellFlag::Reflected);
+    mirrored.assign(grid.flagWords(), 0);
+
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (grid.type(y*W + x) != CellType::Crystal)
+                continue;
+
+            for (int d = 1; ; ++d) {
+                int xs = x - d, xt = x + d;
+                if (xs < 0 || xt >= W) break;
+                if (!grid.has(CellFlag::Traversed, y*W + xs)) continue;
+                mirrored[(y*W + xt) >> 6] |= 1ull << ((y*W + xt) & 63);
+                if (!grid.isWall(y*W + xt)) {
+                    grid.set(CellFlag::Traversed, y*W + xt);
+                    grid.set(CellFlag::Reflected, y*W + xt);
+                }
+            }
+
+            for (int d = 1; ; ++d) {
+                int ys = y - d, yt = y + d;
+                if (ys < 0 || yt >= H) break;
+                if (!grid.has(CellFlag::Traversed, ys*W + x)) continue;
+                mirrored[(yt*W + x) >> 6] |= 1ull << ((yt*W + x) & 63);
+                if (!grid.isWall(yt*W + x)) {
+                    grid.set(CellFlag::Traversed, yt*W + x);
+                    grid.set(CellFlag::Reflected, yt*W + x);
+                }
+            }
+        }
+    }
+}
+
+// Muros, cristales y celdas ya recorridas (nunca un muro) al azar
+static void randomGrid(mt19937& rng, int W, int H, CellGrid& grid) {
+    uniform_real_distribution<double> u(0, 1);
+    double walls = u(rng) * 0.4, crystals = u(rng) * 0.1, traversed = u(rng) * 0.2;
+    grid.resize(W, H);
+    for (int i = 0; i < W * H; ++i) {
+        double r = u(rng);
+        if (r < walls) grid.setType(i, CellType::Wall);
+        else if (r < walls + crystals) grid.setType(i, CellType::Crystal);
+        else if (u(rng) < traversed) grid.set(CellFlag::Traversed, i);
+    }
+}
+
+static vector<vector<int>> crystalRows(const CellGrid& grid) {
+    int W = grid.width(), H = grid.height();
+    vector<vector<int>> rows(H);
+    for (int y = 0; y < H; ++y)
+        for (int x = 0; x < W; ++x)
+            if (grid.type(y*W + x) == CellType::Crystal) rows[y].push_back(x);
+    return rows;
+}
+
+// Primera celda en que difieren las marcas (o el plano de espejadas, si se
+// pasan los dos); -1 si no hay ninguna
+static int firstDifference(const CellGrid& a, const CellGrid& b,
+                           const vector<uint64_t>* mirroredA = nullptr,
+                           const vector<uint64_t>* mirroredB = nullptr) {
+    for (int i = 0; i < a.size(); ++i) {
+        if (a.has(CellFlag::Traversed, i) != b.has(CellFlag::Traversed, i)) return i;
+        if (a.has(CellFlag::Reflected, i) != b.has(CellFlag::Reflected, i)) return i;
+        if (mirroredA && (((*mirroredA)[i >> 6] ^ (*mirroredB)[i >> 6]) >> (i & 63)) & 1) return i;
+    }
+    return -1;
+}
+
+static void report(const char* what, int W, int H, int cell) {
+    printf("%s: %dx%d difiere en (%d,%d)\n", what, W, H, cell % W, cell / W);
+}
+
+static bool kernelMatches(mt19937& rng, int W, int H) {
+    CellGrid expected;
+    randomGrid(rng, W, H, expected);
+    CellGrid actual = expected;
+
+    vector<uint64_t> mirroredExpected, mirroredActual;
+    reflectCrystals(expected, mirroredExpected);
+    MirrorKernel kernel;
+    kernel.run(actual, crystalRows(actual), mirroredActual);
+    mirroredActual.resize(mirroredExpected.size());
+
+    int cell = firstDifference(expected, actual, &mirroredExpected, &mirroredActual);
+    if (cell >= 0) report("MirrorKernel", W, H, cell);
+    return cell < 0;
+}
+
+static bool reflectorMatches(mt19937& rng, int W, int H, int steps) {
+    CellGrid expected;
+    randomGrid(rng, W, H, expected);
+    CellGrid actual = expected;
+    vector<uint64_t> mirrored;
+    CrystalReflector reflector;
+    reflector.reset();
+    uniform_int_distribution<int> anyCell(0, W * H - 1);
+    uniform_int_distribution<int> events(0, 3);
+
+    for (int s = 0; s < steps; ++s) {
+        for (int e = events(rng); e > 0; --e) {
+            int c = anyCell(rng);
+            CellType t = expected.type(c);
+            if (t != CellType::Empty && t != CellType::Wall) continue;
+            t = t == CellType::Empty ? CellType::Wall : CellType::Empty;
+            expected.setType(c, t);
+            actual.setType(c, t);
+            reflector.cellChanged(c % W, c / W);
+        }
+
+        int c = anyCell(rng);
+        if (expected.isWall(c)) continue;
+        expected.set(CellFlag::Traversed, c);
+        reflectCrystals(expected, mirrored);
+        reflector.traverse(actual, c % W, c / W);
+
+        int cell = firstDifference(expected, actual);
+        if (cell >= 0) {
+            report("CrystalReflector", W, H, cell);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    mt19937 rng(1);
+    uniform_int_distribution<int> side(1, 200);
+    const int edges[] = {1, 2, 63, 64, 65, 127, 128, 129, 191, 192, 193};
+
+    int grids = 0;
+    for (int W : edges) {
+        for (int H : edges) {
+            if (!kernelMatches(rng, W, H)) return 1;
+            ++grids;
+        }
+    }
+    for (int n = 0; n < 2000; ++n) {
+        if (!kernelMatches(rng, side(rng), side(rng))) return 1;
+        ++grids;
+    }
+    printf("MirrorKernel: %d tableros iguales a la pasada escalar\n", grids);
+
+    uniform_int_distribution<int> smallSide(1, 80);
+    for (int n = 0; n < 300; ++n) {
+        if (!reflectorMatches(rng, smallSide(rng), smallSide(rng), 60)) return 1;
+    }
+    printf("CrystalReflector: 300 partidas de 60 pasos iguales a la pasada escalar\n");
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Prueba de PathQueries contra BFSWorkspace::solve consulta por consulta:
+// tableros al azar con muros, consultas con inicios repetidos (varias metas
+// por BFS), metas sobre muros, inicio igual a meta y pares sin camino. Se
+// corre con un ThreadPool de un hilo y con uno de cuatro, que reparte los
+// grupos entre hilos aunque la máquina tenga menos núcleos. Devuelve 1 y
+// muestra la primera diferencia si algo no coincide.
+//
+// Se arma con test.bat (o a mano: g++ -O2 -std=c++17 -I include
+// tests/PathQueriesTest.cpp src/BFS.cpp src/Grid.cpp src/GridSnapshot.cpp
+// src/PathQueries.cpp src/ThreadPool.cpp).
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "BFS.hpp"
+#include "Grid.hpp"
+#include "GridSnapshot.hpp"
+#include "PathQueries.hpp"
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+static void randomGrid(mt19937& rng, int W, int H, CellGrid& grid) {
+    uniform_real_distribution<double> u(0, 1);
+    double walls = u(rng) * 0.45;
+    grid.resize(W, H);
+    for (int i = 0; i < W * H; ++i) {
+        if (u(rng) < walls) grid.setType(i, CellType::Wall);
+    }
+}
+
+// Consultas con pocos inicios distintos para que haya grupos de varias metas
+static vector<PathQuery> randomQueries(mt19937& rng, int W, int H, int count) {
+    uniform_int_distribution<int> anyX(0, W - 1), anyY(0, H - 1);
+    vector<pair<int,int>> starts(1 + count / 4);
+    for (auto& s : starts) s = {anyX(rng), anyY(rng)};
+    uniform_int_distribution<int> anyStart(0, (int)starts.size() - 1);
+
+    vector<PathQuery> queries(count);
+    for (PathQuery& q : queries) {
+        auto [x, y] = starts[anyStart(rng)];
+        q = {x, y, anyX(rng), anyY(rng)};
+        if (rng() % 16 == 0) {
+            q.goalX = x;
+            q.goalY = y;
+        }
+    }
+    return queries;
+}
+
+static bool matches(mt19937& rng, PathQueries& batch, int W, int H) {
+    CellGrid grid;
+    randomGrid(rng, W, H, grid);
+    GridSnapshot snapshot(grid);
+    vector<PathQuery> queries = randomQueries(rng, W, H, 1 + rng() % 40);
+
+    vector<int> lengths;
+    batch.solve(snapshot, queries, lengths);
+
+    BFSWorkspace workspace;
+    vector<pair<int,int>> path;
+    for (size_t k = 0; k < queries.size(); ++k) {
+        const PathQuery& q = queries[k];
+        int expected = workspace.solve(grid, W, H, q.startX, q.startY, q.goalX, q.goalY, path)
+                     ? (int)path.size() - 1 : -1;
+        if (lengths[k] != expected) {
+            printf("PathQueries: %dx%d, (%d,%d) -> (%d,%d) da %d y BFSWorkspace %d\n",
+                   W, H, q.startX, q.startY, q.goalX, q.goalY, lengths[k], expected);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    mt19937 rng(1);
+    uniform_int_distribution<int> side(1, 120);
+
+    for (int threads : {1, 4}) {
+        ThreadPool pool(threads);
+        PathQueries batch(pool);
+        for (int n = 0; n < 500; ++n) {
+            // Tamaños que cambian entre llamadas: los espacios de trabajo se rehacen
+            if (!matches(rng, batch, side(rng), side(rng))) return 1;
+        }
+        printf("PathQueries con %d hilo(s): 500 tableros iguales a BFSWorkspace\n", threads);
+    }
+    return 0;
+}
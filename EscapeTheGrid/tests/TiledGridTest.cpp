@@ -0,0 +1,145 @@
+// Prueba de TiledGrid:
+//  - convert() de laberintos de texto al azar (lados a ambos lados de los
+//    múltiplos de 64) y lectura de cada celda con un caché de pocos bloques,
+//    contra loadMazeFile() sobre CellGrid;
+//  - escrituras al azar contra un arreglo de referencia, cerrando y volviendo
+//    a abrir con otro presupuesto de memoria;
+//  - archivos que no se pueden usar: inexistente, cabecera ajena, cortado y
+//    texto incompleto para convert().
+// Escribe sus archivos en la carpeta actual y los borra al terminar. Devuelve
+// 1 y muestra la primera diferencia si algo no coincide.
+//
+// Se arma con test.bat (o a mano: g++ -O2 -std=c++17 -I include
+// tests/TiledGridTest.cpp src/Grid.cpp src/MazeLoader.cpp src/TiledGrid.cpp).
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Grid.hpp"
+#include "MazeLoader.hpp"
+#include "TiledGrid.hpp"
+
+using namespace std;
+
+const char* TEXT_PATH = "tiled_test.txt";
+const char* TILED_PATH = "tiled_test.etgt";
+
+// Laberinto de texto en el formato de assets/maze.txt
+static void writeTextMaze(mt19937& rng, int W, int H) {
+    const char* symbols[] = {".", "#", "C", "K", "."};
+    uniform_int_distribution<int> symbol(0, 4);
+    ofstream out(TEXT_PATH);
+    out << W << " " << H << "\n" << rng() % H << " " << rng() % W << "\n" << rng() % H << " " << rng() % W << "\n";
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) out << symbols[symbol(rng)] << (x + 1 < W ? " " : "\n");
+    }
+}
+
+static bool sameCells(TiledGrid& tiled, const vector<uint8_t>& expected, int W, int H, const char* when) {
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            if (uint8_t(tiled.type(x, y)) != expected[y*W + x]) {
+                printf("TiledGrid: %dx%d %s difiere en (%d,%d)\n", W, H, when, x, y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool roundTrip(mt19937& rng, int W, int H) {
+    writeTextMaze(rng, W, H);
+    CellGrid grid;
+    MazeInfo maze;
+    if (!loadMazeFile(TEXT_PATH, grid, maze) || !TiledGrid::convert(TEXT_PATH, TILED_PATH)) return false;
+    vector<uint8_t> expected(grid.typeData(), grid.typeData() + W * H);
+
+    // Tres bloques en memoria: casi cada fila de bloques desaloja
+    TiledGrid tiled;
+    if (!tiled.open(TILED_PATH, 3 * TiledGrid::TILE * TiledGrid::TILE)) return false;
+    if (tiled.width() != W || tiled.height() != H || tiled.startX() != maze.startX ||
+        tiled.startY() != maze.startY || tiled.goalX() != maze.goalX || tiled.goalY() != maze.goalY) {
+        printf("TiledGrid: %dx%d cabecera distinta de la del texto\n", W, H);
+        return false;
+    }
+    if (!sameCells(tiled, expected, W, H, "al convertir")) return false;
+
+    uniform_int_distribution<int> anyX(0, W - 1), anyY(0, H - 1), anyType(0, 4);
+    for (int k = 0; k < 4 * W * H; ++k) {
+        int x = anyX(rng), y = anyY(rng);
+        if (rng() % 2) {
+            CellType t = CellType(anyType(rng));
+            tiled.setType(x, y, t);
+            expected[y*W + x] = uint8_t(t);
+        } else if (uint8_t(tiled.type(x, y)) != expected[y*W + x]) {
+            printf("TiledGrid: %dx%d difiere en (%d,%d) entre escrituras\n", W, H, x, y);
+            return false;
+        }
+    }
+    if (!tiled.close()) return false;
+
+    if (!tiled.open(TILED_PATH, 1 << 20)) return false;
+    bool same = sameCells(tiled, expected, W, H, "al volver a abrir");
+    return tiled.close() && !tiled.failed() && same;
+}
+
+// Cada caso tiene que fallar en open() o en convert(), con su aviso
+static bool rejectsBadFiles() {
+    TiledGrid tiled;
+    bool ok = true;
+    if (tiled.open("no_existe.etgt", 1 << 20)) {
+        printf("TiledGrid: abrió un archivo inexistente\n");
+        ok = false;
+    }
+
+    ofstream(TILED_PATH, ios::binary) << "no es un archivo de bloques, pero es largo como una cabecera";
+    if (tiled.open(TILED_PATH, 1 << 20)) {
+        printf("TiledGrid: aceptó una cabecera ajena\n");
+        ok = false;
+    }
+
+    mt19937 rng(7);
+    writeTextMaze(rng, 100, 70);
+    TiledGrid::convert(TEXT_PATH, TILED_PATH);
+    string bytes;
+    {
+        ifstream in(TILED_PATH, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    ofstream(TILED_PATH, ios::binary | ios::trunc).write(bytes.data(), bytes.size() - 100);
+    if (tiled.open(TILED_PATH, 1 << 20)) {
+        printf("TiledGrid: aceptó un archivo cortado\n");
+        ok = false;
+    }
+
+    // Cabecera de 100x70 con solo 3 filas
+    ofstream(TEXT_PATH, ios::trunc) << "100 70\n0 0\n1 1\n# . .\n";
+    if (TiledGrid::convert(TEXT_PATH, TILED_PATH)) {
+        printf("TiledGrid: convirtió un texto incompleto\n");
+        ok = false;
+    }
+    return ok;
+}
+
+int main() {
+    mt19937 rng(1);
+    const int sides[] = {1, 63, 64, 65, 130};
+    int grids = 0;
+    bool ok = true;
+    for (int W : sides) {
+        for (int H : sides) {
+            ok = ok && roundTrip(rng, W, H);
+            ++grids;
+        }
+    }
+    if (ok) printf("TiledGrid: %d tableros iguales a loadMazeFile() y a la referencia\n", grids);
+    ok = ok && rejectsBadFiles();
+    if (ok) printf("TiledGrid: archivos inexistentes, ajenos, cortados e incompletos rechazados\n");
+
+    remove(TEXT_PATH);
+    remove(TILED_PATH);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// Prueba de deshacer y rehacer turnos como lo hace el juego:
+//  - partidas al azar con movimientos, reflejos, la meta que se mueve cada
+//    10 turnos y un muro que aparece o desaparece cada 5, como
+//    tryMovePlayer();
+//  - saltos al azar por el historial (deshacer, rehacer y turnos lejanos,
+//    pasando por puntos de control) con los índices puestos al día desde
+//    TurnHistory::lastRestored() como en restoreTurn();
+//  - después de cada salto, la grilla contra una copia guardada del mismo
+//    turno, FreeCellSet contra rebuild() y, en el paso siguiente,
+//    CrystalReflector contra uno nuevo que recalcula todo.
+// Devuelve 1 y muestra la primera diferencia si algo no coincide.
+//
+// Se arma con test.bat (o a mano: g++ -O2 -std=c++17 -I include
+// tests/TurnHistoryTest.cpp src/CrystalReflector.cpp src/FreeCellSet.cpp
+// src/Grid.cpp src/GridSnapshot.cpp src/MirrorKernel.cpp src/TurnHistory.cpp).
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "CrystalReflector.hpp"
+#include "FreeCellSet.hpp"
+#include "Grid.hpp"
+#include "TurnHistory.hpp"
+
+using namespace std;
+
+struct Game {
+    int W = 0, H = 0;
+    CellGrid grid;
+    FreeCellSet freeCells;
+    CrystalReflector reflector;
+    TurnHistory history;
+    TurnState state;
+    vector<CellGrid> saved;   // saved[t]: la grilla al final del turno t
+};
+
+static void start(mt19937& rng, Game& g, int W, int H) {
+    uniform_real_distribution<double> u(0, 1);
+    double walls = u(rng) * 0.3, crystals = u(rng) * 0.08;
+    g.W = W;
+    g.H = H;
+    g.grid.setJournal(nullptr);
+    g.grid.resize(W, H);
+    for (int i = 0; i < W * H; ++i) {
+        double r = u(rng);
+        if (r < walls) g.grid.setType(i, CellType::Wall);
+        else if (r < walls + crystals) g.grid.setType(i, CellType::Crystal);
+    }
+    g.grid.setType(0, CellType::Start);
+    g.grid.setType(W * H - 1, CellType::Goal);
+    g.state = {0, 0, W - 1, H - 1, 0, 0, -1};
+
+    // Como resetGame()
+    g.reflector.reset();
+    g.freeCells.rebuild(g.grid);
+    g.reflector.traverse(g.grid, 0, 0);
+    g.history.reset(g.grid, g.state);
+    g.saved.assign(1, g.grid);
+    g.saved[0].setJournal(nullptr);
+}
+
+// Un turno de tryMovePlayer() hacia (x,y)
+static void play(mt19937& rng, Game& g, int x, int y) {
+    int W = g.W;
+    TurnState& s = g.state;
+    s.playerX = x;
+    s.playerY = y;
+    g.reflector.traverse(g.grid, x, y);
+    s.turnCount++;
+    s.turnsSinceLastGoalMove++;
+
+    if (s.turnsSinceLastGoalMove >= 10) {
+        int target = g.freeCells.pick(y*W + x);
+        if (target >= 0) {
+            g.grid.setType(s.goalY*W + s.goalX, CellType::Empty);
+            g.freeCells.insert(s.goalY*W + s.goalX);
+            s.goalX = target % W;
+            s.goalY = target / W;
+            g.grid.setType(target, CellType::Goal);
+            g.freeCells.erase(target);
+        }
+        s.turnsSinceLastGoalMove = 0;
+    }
+
+    s.eventCell = -1;
+    if (s.turnCount % 5 == 0) {
+        int c = uniform_int_distribution<int>(0, W * g.H - 1)(rng);
+        CellType t = g.grid.type(c);
+        if (t == CellType::Empty || t == CellType::Wall) {
+            g.grid.setType(c, t == CellType::Empty ? CellType::Wall : CellType::Empty);
+            if (t == CellType::Empty) g.freeCells.erase(c);
+            else g.freeCells.insert(c);
+            g.reflector.cellChanged(c % W, c / W);
+            s.eventCell = c;
+        }
+    }
+
+    g.history.commit(g.grid, s);
+    g.saved.resize(s.turnCount);
+    g.saved.push_back(g.grid);
+    g.saved.back().setJournal(nullptr);
+}
+
+// Un paso al azar a una celda vecina transitable, o quedarse
+static void nextMove(mt19937& rng, const Game& g, int& x, int& y) {
+    const int dx[4] = {0, 0, 1, -1}, dy[4] = {1, -1, 0, 0};
+    int d = rng() % 4;
+    x = g.state.playerX;
+    y = g.state.playerY;
+    if (g.grid.passable(x + dx[d], y + dy[d])) {
+        x += dx[d];
+        y += dy[d];
+    }
+}
+
+// Como restoreTurn() en main.cpp
+static void restore(Game& g) {
+    int W = g.W;
+    for (const CellChange& c : g.history.lastRestored()) {
+        if (c.plane != 0) continue;
+        if (g.grid.type(c.cell) == CellType::Empty) g.freeCells.insert(c.cell);
+        else g.freeCells.erase(c.cell);
+    }
+    g.reflector.turnRestored(g.grid, g.history.lastRestored());
+    if (g.state.eventCell >= 0) g.reflector.cellChanged(g.state.eventCell % W, g.state.eventCell / W);
+}
+
+// Primera celda en que difieren tipo o marcas del historial; -1 si ninguna
+static int firstDifference(const CellGrid& a, const CellGrid& b, bool types) {
+    for (int i = 0; i < a.size(); ++i) {
+        if (types && a.type(i) != b.type(i)) return i;
+        if (a.has(CellFlag::Traversed, i) != b.has(CellFlag::Traversed, i)) return i;
+        if (a.has(CellFlag::Reflected, i) != b.has(CellFlag::Reflected, i)) return i;
+    }
+    return -1;
+}
+
+static bool freeCellsMatch(const Game& g) {
+    FreeCellSet rebuilt;
+    rebuilt.rebuild(g.grid);
+    for (int i = 0; i < g.grid.size(); ++i) {
+        if (g.freeCells.contains(i) != rebuilt.contains(i)) {
+            printf("FreeCellSet: turno %d difiere de rebuild() en (%d,%d)\n",
+                   g.history.turn(), i % g.W, i / g.W);
+            return false;
+        }
+    }
+    return g.freeCells.size() == rebuilt.size();
+}
+
+static bool gameMatches(mt19937& rng, int W, int H, int turns) {
+    Game g;
+    start(rng, g, W, H);
+    int x, y;
+    for (int t = 0; t < turns; ++t) {
+        if (rng() % 4 != 0 || g.history.lastTurn() == 0) {
+            nextMove(rng, g, x, y);
+            play(rng, g, x, y);
+            continue;
+        }
+
+        int target;
+        switch (rng() % 3) {
+            case 0: target = g.history.turn() - 1; break;
+            case 1: target = g.history.turn() + 1; break;
+            default: target = uniform_int_distribution<int>(0, g.history.lastTurn())(rng); break;
+        }
+        if (!g.history.jumpTo(target, g.grid, g.state)) continue;
+        restore(g);
+
+        int cell = firstDifference(g.grid, g.saved[target], true);
+        if (cell >= 0) {
+            printf("TurnHistory: %dx%d, turno %d difiere de la copia en (%d,%d)\n", W, H, target, cell % W, cell / W);
+            return false;
+        }
+        if (!freeCellsMatch(g)) return false;
+
+        // El paso siguiente, contra un reflector que recalcula todo
+        CellGrid reference = g.grid;
+        reference.setJournal(nullptr);
+        CrystalReflector fresh;
+        nextMove(rng, g, x, y);
+        fresh.traverse(reference, x, y);
+        play(rng, g, x, y);
+        cell = firstDifference(g.grid, reference, false);
+        if (cell >= 0) {
+            printf("CrystalReflector: %dx%d, paso tras volver al turno %d difiere en (%d,%d)\n",
+                   W, H, target, cell % W, cell / W);
+            return false;
+        }
+        if (!freeCellsMatch(g)) return false;
+    }
+    return true;
+}
+
+int main() {
+    mt19937 rng(1);
+    uniform_int_distribution<int> side(2, 90);
+    for (int n = 0; n < 300; ++n) {
+        if (!gameMatches(rng, side(rng), side(rng), 200)) return 1;
+    }
+    printf("TurnHistory: 300 partidas de 200 turnos con saltos iguales a las copias y a rebuild()\n");
+    return 0;
+}